@@ -0,0 +1,432 @@
+// Benchmark harness for the part_1 algorithm engines.
+// Build: make bench
+// Run:   ./bin/bench [threads]
+
+#include "../include/graph.hpp"
+#include "../include/generators.hpp"
+#include "../include/mst.hpp"
+#include "../include/maxflow.hpp"
+#include "../include/intersect.hpp"
+#include "../include/triangles.hpp"
+#include "../include/reorder.hpp"
+#include "../include/compressed_graph.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace osproj;
+
+extern std::vector<int> find_euler_circuit(const Graph&);
+extern std::vector<int> find_euler_circuit(const CompressedGraph&);
+
+// Hardware cache-miss counter for the calling thread; reports -1 where perf events are
+// unavailable (no PMU, containers, perf_event_paranoid).
+class CacheMisses {
+public:
+    CacheMisses() {
+        perf_event_attr pe{};
+        pe.type = PERF_TYPE_HARDWARE;
+        pe.size = sizeof(pe);
+        pe.config = PERF_COUNT_HW_CACHE_MISSES;
+        pe.disabled = 1;
+        pe.exclude_kernel = 1;
+        pe.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0));
+    }
+    ~CacheMisses() { if (_fd >= 0) close(_fd); }
+
+    void start() {
+        if (_fd < 0) return;
+        ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    long long stop() {
+        if (_fd < 0) return -1;
+        ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(_fd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+    }
+
+private:
+    int _fd = -1;
+};
+
+// Best of `reps` wall-clock runs, in milliseconds.
+static double time_ms(const std::function<void()>& fn, int reps = 3) {
+    double best = 1e300;
+    for (int i = 0; i < reps; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+static void bench_mst(const std::string& name, const Graph& g, unsigned threads) {
+    MstResult k, b;
+    double tk = time_ms([&] { k = mst_kruskal(g.vertex_count(), g.edges(), threads); });
+    double tb = time_ms([&] { b = mst_boruvka(g.vertex_count(), g.edges(), threads); });
+    std::printf("%-18s %9zu %9zu %12.2f %12.2f %8s\n", name.c_str(), g.vertex_count(), g.edge_count(),
+                tk, tb, k.edges == b.edges ? "yes" : "NO");
+}
+
+static void bench_flow(const std::string& name, const Graph& g, int s, int t) {
+    MaxFlowResult r;
+    double ms = time_ms([&] { r = max_flow(g, s, t); }, 1);
+    std::printf("%-18s %9zu %9zu %12.2f %14g %10zu\n", name.c_str(), g.vertex_count(), g.edge_count(),
+                ms, r.value, r.source_side.size());
+}
+
+// Strictly increasing list of n values drawn from [0, universe).
+static std::vector<int> sorted_sample(size_t n, int universe, std::mt19937& rng) {
+    std::vector<int> v;
+    std::uniform_int_distribution<int> d(0, universe - 1);
+    while (v.size() < n) {
+        for (size_t i = v.size(); i < n; ++i) v.push_back(d(rng));
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+    }
+    return v;
+}
+
+static void bench_intersect(size_t na, size_t nb) {
+    std::mt19937 rng(static_cast<unsigned>(na * 31 + nb));
+    int universe = static_cast<int>(std::max(na, nb) * 4);
+    std::vector<int> a = sorted_sample(na, universe, rng), b = sorted_sample(nb, universe, rng);
+    size_t reps = std::max<size_t>(1, 20000000 / (na + nb));
+    std::printf("%8zu %8zu", na, nb);
+    for (IntersectKernel k : {IntersectKernel::SCALAR, IntersectKernel::GALLOP, IntersectKernel::SIMD}) {
+        size_t sink = 0;
+        double ms = time_ms([&] {
+            for (size_t r = 0; r < reps; ++r) sink += intersect_count(a.data(), a.size(), b.data(), b.size(), k);
+        });
+        std::printf(" %12.1f", ms * 1e6 / reps);
+        if (sink == 0 && na > 0) std::printf("?");
+    }
+    std::printf("\n");
+}
+
+static void bench_triangles(const std::string& name, const Graph& g) {
+    SortedAdjacency a = sorted_adjacency(g);
+    std::printf("%-18s %9zu %9zu", name.c_str(), g.vertex_count(), g.edge_count());
+    uint64_t count = 0;
+    for (IntersectKernel k : {IntersectKernel::SCALAR, IntersectKernel::GALLOP, IntersectKernel::SIMD, IntersectKernel::AUTO}) {
+        double ms = time_ms([&] { count = count_triangles(a, k); }, 1);
+        std::printf(" %10.1f", ms);
+    }
+    std::printf(" %12llu\n", static_cast<unsigned long long>(count));
+}
+
+// Full BFS over every component; returns edges scanned.
+template <typename G>
+static size_t bfs_all(const G& g) {
+    size_t n = g.vertex_count(), scanned = 0;
+    std::vector<char> seen(n, 0);
+    std::vector<int> q;
+    q.reserve(n);
+    for (size_t r = 0; r < n; ++r) {
+        if (seen[r]) continue;
+        seen[r] = 1;
+        q.push_back(static_cast<int>(r));
+        for (size_t h = q.size() - 1; h < q.size(); ++h) {
+            for (const auto& e : g.neighbors(q[h])) {
+                ++scanned;
+                if (!seen[e.to]) { seen[e.to] = 1; q.push_back(e.to); }
+            }
+        }
+    }
+    return scanned;
+}
+
+static size_t bfs_all(const Graph& g) {
+    return g.visit([](const auto& bg) { return bfs_all(bg); });
+}
+
+// PageRank-style gather: every vertex sums a value over its neighbours.
+template <typename G>
+static double neighbor_sweep(const G& g, int rounds) {
+    size_t n = g.vertex_count();
+    std::vector<double> val(n, 1.0), next(n);
+    for (int r = 0; r < rounds; ++r) {
+        for (size_t u = 0; u < n; ++u) {
+            const auto& adj = g.neighbors(static_cast<int>(u));
+            double acc = 0;
+            for (const auto& e : adj) acc += val[e.to];
+            next[u] = 0.5 + 0.5 * acc / (adj.size() + 1);
+        }
+        val.swap(next);
+    }
+    return val[0];
+}
+
+static double neighbor_sweep(const Graph& g, int rounds) {
+    return g.visit([rounds](const auto& bg) { return neighbor_sweep(bg, rounds); });
+}
+
+// Full BFS straight off the compressed byte stream.
+static size_t bfs_all(const CompressedGraph& g) {
+    return g.visit([](const auto& cg) { return bfs_all(cg); });
+}
+
+// Sum of the weights seen while scanning every adjacency list.
+template <typename G>
+static double weight_sum(const G& g) {
+    return g.visit([](const auto& bg) {
+        double sum = 0;
+        for (size_t u = 0; u < bg.vertex_count(); ++u)
+            for (const auto& e : bg.neighbors(static_cast<int>(u))) sum += e.weight();
+        return sum;
+    });
+}
+
+// Heap bytes of the uncompressed layout: adjacency vectors, edge list and degree counters.
+static size_t plain_bytes(const Graph& g) {
+    return g.visit([](const auto& bg) {
+        using G = std::decay_t<decltype(bg)>;
+        size_t n = bg.vertex_count();
+        size_t b = bg.edges().capacity() * sizeof(EdgeRecord) + n * sizeof(std::vector<int>) +
+                   n * sizeof(int) * (G::is_directed ? 2 : 1);
+        for (size_t u = 0; u < n; ++u)
+            b += bg.neighbors(static_cast<int>(u)).capacity() * sizeof(typename G::edge_type);
+        return b;
+    });
+}
+
+// One row for the uncompressed layout, then one per weight coding: bytes per edge, build
+// time, BFS throughput and the relative error of the summed weights.
+static void bench_compressed(const std::string& name, const Graph& g) {
+    size_t scanned = 0;
+    double bfs = time_ms([&] { scanned = bfs_all(g); });
+    double m = static_cast<double>(g.edge_count()), bytes = static_cast<double>(plain_bytes(g));
+    double wsum = weight_sum(g);
+    std::printf("%-14s %-6s %9.1f %7.2f %9s %9.1f %9.1f %10s\n", name.c_str(), "plain", bytes / 1048576.0,
+                bytes / m, "-", bfs, scanned / bfs / 1e3, "-");
+
+    std::vector<std::pair<const char*, WeightCoding>> codings = {{"varint", WeightCoding::NONE}};
+    if (g.weighted()) codings = {{"dict", WeightCoding::DICTIONARY}, {"quant", WeightCoding::QUANTIZED}};
+    for (const auto& [label, coding] : codings) {
+        std::optional<CompressedGraph> cg;
+        double build = time_ms([&] { cg.emplace(g, coding); }, 1);
+        size_t cscanned = 0;
+        double cbfs = time_ms([&] { cscanned = bfs_all(*cg); });
+        double cbytes = static_cast<double>(cg->memory_bytes());
+        double err = std::abs(weight_sum(*cg) - wsum) / wsum;
+        std::printf("%-14s %-6s %9.1f %7.2f %9.1f %9.1f %9.1f %10.2e%s\n", name.c_str(), label,
+                    cbytes / 1048576.0, cbytes / m, build, cbfs, cscanned / cbfs / 1e3, err,
+                    cscanned == scanned ? "" : "  MISMATCH");
+    }
+}
+
+// Same topology as an unweighted and a weighted graph: adjacency bytes and BFS time,
+// through the visit() fast path and through the runtime NeighborRange wrapper.
+static void bench_flavours(const std::string& name, size_t n, size_t m) {
+    Graph plain = random_gnm(n, m, 21);
+    Graph weighted = random_gnm(n, m, 21, GraphType::UNDIRECTED, 100);
+    for (const Graph* g : {&plain, &weighted}) {
+        size_t entry = g->weighted() ? sizeof(BasicEdge<double>) : sizeof(BasicEdge<void>);
+        size_t entries = g->visit([](const auto& bg) {
+            size_t c = 0;
+            for (size_t u = 0; u < bg.vertex_count(); ++u) c += bg.neighbors(static_cast<int>(u)).size();
+            return c;
+        });
+        double fast = time_ms([&] { bfs_all(*g); });
+        double wrapped = time_ms([&] {
+            size_t scanned = 0;
+            std::vector<char> seen(g->vertex_count(), 0);
+            std::vector<int> q;
+            for (size_t r = 0; r < g->vertex_count(); ++r) {
+                if (seen[r]) continue;
+                seen[r] = 1;
+                q.assign(1, static_cast<int>(r));
+                for (size_t h = 0; h < q.size(); ++h)
+                    for (const Edge& e : g->neighbors(q[h])) {
+                        ++scanned;
+                        if (!seen[e.to]) { seen[e.to] = 1; q.push_back(e.to); }
+                    }
+            }
+            return scanned;
+        });
+        std::printf("%-14s %-10s %7zu %12.1f %10.1f %12.1f\n", name.c_str(), g->weighted() ? "weighted" : "unweighted",
+                    entry, entries * entry / 1048576.0, fast, wrapped);
+    }
+}
+
+static Graph scrambled(const Graph& g, unsigned seed) {
+    std::vector<int> perm(g.vertex_count());
+    for (size_t i = 0; i < perm.size(); ++i) perm[i] = static_cast<int>(i);
+    std::shuffle(perm.begin(), perm.end(), std::mt19937(seed));
+    return relabel(g, perm).graph;
+}
+
+static void print_miss(long long m) {
+    if (m < 0) std::printf(" %12s", "n/a");
+    else std::printf(" %12lld", m);
+}
+
+static void bench_ordering(const std::string& name, const Graph& input) {
+    struct Variant { const char* label; bool reorder; Ordering o; };
+    const Variant variants[] = {
+        {"random", false, Ordering::BFS}, {"rcm", true, Ordering::RCM},
+        {"degree", true, Ordering::DEGREE}, {"bfs", true, Ordering::BFS},
+    };
+    CacheMisses pmu;
+    for (const Variant& v : variants) {
+        Reordered r;
+        double prep = v.reorder ? time_ms([&] { r = reorder(input, v.o); }, 1) : 0;
+        const Graph& g = v.reorder ? r.graph : input;
+
+        size_t scanned = 0;
+        pmu.start();
+        double bfs = time_ms([&] { scanned = bfs_all(g); });
+        long long bfs_miss = pmu.stop();
+        double sink = 0;
+        pmu.start();
+        double sweep = time_ms([&] { sink += neighbor_sweep(g, 5); });
+        long long sweep_miss = pmu.stop();
+        (void)sink;
+
+        std::printf("%-14s %-8s %10.1f %10.1f %10.1f", name.c_str(), v.label, prep, bfs, scanned / bfs / 1e3);
+        print_miss(bfs_miss);
+        std::printf(" %10.1f", sweep);
+        print_miss(sweep_miss);
+        std::printf("\n");
+    }
+}
+
+static void bench_euler_ordering(const Graph& input) {
+    const char* labels[] = {"random", "rcm", "degree", "bfs"};
+    const Ordering orders[] = {Ordering::BFS, Ordering::RCM, Ordering::DEGREE, Ordering::BFS};
+    CacheMisses pmu;
+    for (int i = 0; i < 4; ++i) {
+        Reordered r;
+        if (i > 0) r = reorder(input, orders[i]);
+        const Graph& g = i > 0 ? r.graph : input;
+        size_t len = 0;
+        pmu.start();
+        double ms = time_ms([&] { len = find_euler_circuit(g).size(); }, 1);
+        long long miss = pmu.stop();
+        std::printf("%-14s %-8s %10.1f", "euler grid x2", labels[i], ms);
+        print_miss(miss);
+        std::printf(" %10zu\n", len);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+
+    std::printf("== MST (threads=%u, 0 = all cores) ==\n", threads);
+    std::printf("%-18s %9s %9s %12s %12s %8s\n", "graph", "n", "m", "kruskal_ms", "boruvka_ms", "same");
+    bench_mst("gnm sparse", random_gnm(10000, 40000, 1, GraphType::UNDIRECTED, 1000), threads);
+    bench_mst("gnm sparse", random_gnm(100000, 400000, 2, GraphType::UNDIRECTED, 1000), threads);
+    bench_mst("gnm sparse", random_gnm(1000000, 4000000, 3, GraphType::UNDIRECTED, 1000), threads);
+    bench_mst("gnm dense", random_gnm(20000, 2000000, 4, GraphType::UNDIRECTED, 1000), threads);
+    bench_mst("gnm unit weights", random_gnm(100000, 400000, 5), threads);
+    bench_mst("grid", random_grid(300, 300, 6, 100), threads);
+    bench_mst("grid", random_grid(1000, 1000, 7, 100), threads);
+
+    std::printf("\n== MAX_FLOW (push-relabel) ==\n");
+    std::printf("%-18s %9s %9s %12s %14s %10s\n", "graph", "n", "m", "ms", "flow", "s_side");
+    bench_flow("gnm directed", random_gnm(100000, 1000000, 8, GraphType::DIRECTED, 100), 0, 1);
+    bench_flow("gnm directed", random_gnm(1000000, 4000000, 9, GraphType::DIRECTED, 100), 0, 1);
+    bench_flow("grid", random_grid(1000, 1000, 10, 100), 0, 999999);
+    {
+        // s feeds every vertex of a path that ends in t: one gap per relabel round
+        const int n = 1000000, s = n - 2, t = n - 1;
+        Graph chain(n, GraphType::DIRECTED);
+        for (int i = 0; i < n - 2; ++i) chain.add_edge(s, i);
+        for (int i = 0; i + 1 < n - 2; ++i) chain.add_edge(i, i + 1);
+        chain.add_edge(n - 3, t);
+        bench_flow("gap chain", chain, s, t);
+    }
+
+    std::printf("\n== Sorted-set intersection, ns per call (simd = %s) ==\n", simd_level());
+    std::printf("%8s %8s %12s %12s %12s\n", "|a|", "|b|", "scalar", "gallop", "simd");
+    bench_intersect(16, 16);
+    bench_intersect(256, 256);
+    bench_intersect(4096, 4096);
+    bench_intersect(100000, 100000);
+    bench_intersect(64, 4096);
+    bench_intersect(100, 100000);
+
+    std::printf("\n== TRIANGLES, ms per kernel (auto = bitset for hubs + gallop/simd) ==\n");
+    std::printf("%-18s %9s %9s %10s %10s %10s %10s %12s\n", "graph", "n", "m", "scalar", "gallop", "simd", "auto", "triangles");
+    bench_triangles("gnm dense", random_gnm(3000, 1000000, 11));
+    bench_triangles("gnm sparse", random_gnm(500000, 4000000, 12));
+    bench_triangles("grid", random_grid(1000, 1000, 13));
+
+    std::printf("\n== MAX_CLIQUE estimate ==\n");
+    for (size_t n : {2000, 20000}) {
+        Graph g = random_gnm(n, n * 50, 14);
+        CliqueEstimate est;
+        double ms = time_ms([&] { est = max_clique_estimate(g); }, 1);
+        std::printf("gnm n=%-9zu m=%-9zu %10.1f ms  clique >= %zu, <= %d\n", n, g.edge_count(), ms,
+                    est.clique.size(), est.upper_bound);
+    }
+
+    std::printf("\n== Graph flavours (BasicGraph<Direction, Weight>) ==\n");
+    std::printf("%-14s %-10s %7s %12s %10s %12s\n", "graph", "flavour", "B/entry", "adj_MiB", "bfs_ms", "wrapper_ms");
+    bench_flavours("gnm 1M/4M", 1000000, 4000000);
+
+    std::printf("\n== Vertex ordering (input labels shuffled; misses = HW cache misses, all reps) ==\n");
+    std::printf("%-14s %-8s %10s %10s %10s %12s %10s %12s\n", "graph", "order", "prep_ms", "bfs_ms",
+                "bfs_Me/s", "bfs_miss", "sweep_ms", "sweep_miss");
+    bench_ordering("grid 1000^2", scrambled(random_grid(1000, 1000, 15), 16));
+    bench_ordering("gnm 1M/4M", scrambled(random_gnm(1000000, 4000000, 17), 18));
+    {
+        Graph grid = random_grid(200, 200, 19);
+        Graph twice(grid.vertex_count(), GraphType::UNDIRECTED);
+        for (const auto& e : grid.edges()) { twice.add_edge(e.u, e.v); twice.add_edge(e.u, e.v); }
+        std::printf("%-14s %-8s %10s %12s %10s\n", "graph", "order", "euler_ms", "euler_miss", "circuit");
+        bench_euler_ordering(scrambled(twice, 20));
+    }
+
+    std::printf("\n== Compressed adjacency (gap varint; B/edge counts everything held per edge) ==\n");
+    std::printf("%-14s %-6s %9s %7s %9s %9s %9s %10s\n", "graph", "layout", "MiB", "B/edge", "build_ms",
+                "bfs_ms", "bfs_Me/s", "wsum_err");
+    {
+        Graph gnm = random_gnm(1000000, 8000000, 22);
+        bench_compressed("gnm 1M/8M", gnm);
+        bench_compressed("gnm 1M/8M rcm", reorder(gnm, Ordering::RCM).graph);
+
+        // Streamed from a part_1 file through a 32 MiB staging budget; no Graph is built.
+        const std::string path = "/tmp/osproj_bench_gnm.txt";
+        { std::ofstream out(path); out << gnm; }
+        const size_t budget = size_t(1) << 22;
+        std::optional<CompressedGraph> cg;
+        double build = time_ms([&] { cg = CompressedGraph::from_file(path, WeightCoding::NONE, budget); }, 1);
+        size_t scanned = 0;
+        double bfs = time_ms([&] { scanned = bfs_all(*cg); });
+        std::printf("%-14s %-6s %9.1f %7.2f %9.1f %9.1f %9.1f %10s  (from file, %zu MiB staged/pass)\n",
+                    "gnm 1M/8M", "stream", cg->memory_bytes() / 1048576.0,
+                    cg->memory_bytes() / double(cg->edge_count()), build, bfs, scanned / bfs / 1e3, "-",
+                    budget * 8 >> 20);
+        std::remove(path.c_str());
+    }
+    bench_compressed("gnm directed", random_gnm(1000000, 8000000, 23, GraphType::DIRECTED));
+    bench_compressed("grid w=100", random_grid(1000, 1000, 24, 100));
+    {
+        Graph grid = random_grid(200, 200, 25);
+        Graph twice(grid.vertex_count(), GraphType::UNDIRECTED);
+        for (const auto& e : grid.edges()) { twice.add_edge(e.u, e.v); twice.add_edge(e.u, e.v); }
+        CompressedGraph cg(twice);
+        std::vector<int> a, b;
+        double plain = time_ms([&] { a = find_euler_circuit(twice); }, 1);
+        double packed = time_ms([&] { b = find_euler_circuit(cg); }, 1);
+        std::printf("%-14s euler_ms plain %.1f, compressed %.1f, circuit %zu, same=%s\n", "euler grid x2",
+                    plain, packed, a.size(), a == b ? "yes" : "no");
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+namespace osproj {
+
+// Direction tags for BasicGraph.
+struct Directed   { static constexpr bool directed = true; };
+struct Undirected { static constexpr bool directed = false; };
+
+// Adjacency entry. Unweighted graphs (W = void) store no weight: 8 bytes instead of 16.
+template <typename W>
+struct BasicEdge {
+    int to;
+    int id;
+    W w;
+
+    double weight() const { return static_cast<double>(w); }
+};
+
+template <>
+struct BasicEdge<void> {
+    int to;
+    int id;
+
+    static constexpr double weight() { return 1.0; }
+};
+
+using Edge = BasicEdge<double>;
+
+// Canonical edge list entry (insertion order, id == index), shared by all graph
+// flavours so the algorithm engines can take one edge-list type.
+struct EdgeRecord {
+    int id;
+    int u, v;
+    double w;
+};
+
+namespace detail {
+
+// In-degree counters exist only for directed graphs; for undirected graphs every
+// edge is counted on both endpoints, so in-degree equals out-degree.
+template <bool Directed>
+struct InDegrees {
+    void resize(size_t) {}
+    void push_back() {}
+    void increment(int) {}
+};
+
+template <>
+struct InDegrees<true> {
+    std::vector<int> count;
+
+    void resize(size_t n) { count.resize(n, 0); }
+    void push_back() { count.push_back(0); }
+    void increment(int v) { count[v]++; }
+};
+
+} // namespace detail
+
+// Graph specialised at compile time on direction and weight type, so the hot loops
+// carry no direction branches and unweighted graphs carry no weights.
+template <typename Direction, typename W = double>
+class BasicGraph {
+public:
+    using direction_type = Direction;
+    using weight_type = W;
+    using edge_type = BasicEdge<W>;
+
+    static constexpr bool is_directed = Direction::directed;
+    static constexpr bool is_weighted = !std::is_void<W>::value;
+
+    explicit BasicGraph(size_t n = 0) : _n(n), _adj(n), _outdeg(n, 0) { _in.resize(n); }
+
+    void resize(size_t n) {
+        _n = n;
+        _adj.resize(n);
+        _in.resize(n);
+        _outdeg.resize(n, 0);
+        _edges.clear();
+    }
+
+    int add_vertex() {
+        _adj.emplace_back();
+        _in.push_back();
+        _outdeg.push_back(0);
+        return static_cast<int>(_n++);
+    }
+
+    // Unweighted edge (weight 1 on weighted graphs).
+    void add_edge(int u, int v) {
+        if constexpr (is_weighted) add_edge(u, v, W(1));
+        else insert(u, v, 1.0, edge_type{v, next_id()}, edge_type{u, next_id()});
+    }
+
+    template <typename WW = W, typename = std::enable_if_t<!std::is_void<WW>::value>>
+    void add_edge(int u, int v, WW w) {
+        insert(u, v, static_cast<double>(w), edge_type{v, next_id(), w}, edge_type{u, next_id(), w});
+    }
+
+    void reserve_edges(size_t m) { _edges.reserve(m); }
+
+    size_t vertex_count() const { return _n; }
+    size_t edge_count() const { return _edges.size(); }
+
+    const std::vector<edge_type>& neighbors(int u) const {
+        validate_vertex(u);
+        return _adj[u];
+    }
+    const std::vector<EdgeRecord>& edges() const { return _edges; }
+
+    int out_degree(int u) const {
+        validate_vertex(u);
+        return _outdeg[u];
+    }
+
+    int in_degree(int u) const {
+        validate_vertex(u);
+        if constexpr (is_directed) return _in.count[u];
+        else return _outdeg[u];
+    }
+
+    int degree(int u) const { return out_degree(u); }
+
+    void validate_vertex(int u) const {
+        if (u < 0 || static_cast<size_t>(u) >= _n)
+            throw std::out_of_range("Invalid vertex: " + std::to_string(u));
+    }
+
+private:
+    size_t _n{};
+    std::vector<std::vector<edge_type>> _adj;
+    std::vector<EdgeRecord> _edges;
+    std::vector<int> _outdeg;
+    detail::InDegrees<is_directed> _in;
+
+    int next_id() const { return static_cast<int>(_edges.size()); }
+
+    void insert(int u, int v, double w, const edge_type& fwd, const edge_type& back) {
+        validate_vertex(u);
+        validate_vertex(v);
+        _edges.push_back({next_id(), u, v, w});
+        _adj[u].push_back(fwd);
+        _outdeg[u]++;
+        if constexpr (is_directed) {
+            _in.increment(v);
+        } else if (u != v) {
+            _adj[v].push_back(back);
+            _outdeg[v]++;
+        }
+    }
+};
+
+} // namespace osproj
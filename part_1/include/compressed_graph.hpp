@@ -0,0 +1,226 @@
+#pragma once
+
+#include "graph.hpp"
+#include <cstdint>
+#include <functional>
+#include <variant>
+
+namespace osproj {
+
+// How a compressed graph stores edge weights.
+enum class WeightCoding {
+    NONE,       // weights dropped, every edge reads as 1
+    DICTIONARY, // exact: distinct weights in a table, varint index per edge (most frequent first)
+    QUANTIZED   // lossy: one byte per edge, 256 levels between the smallest and largest weight
+};
+
+// Replays the whole edge list into emit(u, v, w). The streaming builders call it once per
+// pass, so it must produce the same edges every time (re-read a file, walk chunks, ...).
+using EdgeSink = std::function<void(int u, int v, double w)>;
+using EdgeScan = std::function<void(const EdgeSink& emit)>;
+
+namespace detail {
+
+// LEB128: 7 bits per byte, high bit set on every byte but the last.
+inline void put_varint(std::vector<uint8_t>& out, uint32_t x) {
+    while (x >= 0x80) {
+        out.push_back(static_cast<uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(x));
+}
+
+inline uint32_t get_varint(const uint8_t*& p) {
+    uint32_t x = *p & 0x7f;
+    if (*p++ < 0x80) return x; // most gaps fit in one byte
+    for (int shift = 7;; shift += 7) {
+        x |= static_cast<uint32_t>(*p & 0x7f) << shift;
+        if (*p++ < 0x80) return x;
+    }
+}
+
+// Byte stream behind BasicCompressedGraph. Each vertex's list is its degree followed by
+// (target gap, weight code) per edge, with targets ascending; the first gap is from 0.
+struct CompressedAdjacency {
+    std::vector<uint64_t> off;  // byte offset of each list, n + 1 entries
+    std::vector<uint8_t> bytes;
+    std::vector<int> in_deg;    // directed graphs only
+    size_t edge_count = 0;
+
+    WeightCoding coding = WeightCoding::NONE;
+    std::vector<double> dict;   // DICTIONARY
+    double lo = 0, step = 0;    // QUANTIZED: w = lo + code * step
+
+    double get_weight(const uint8_t*& p) const {
+        switch (coding) {
+        case WeightCoding::DICTIONARY: return dict[get_varint(p)];
+        case WeightCoding::QUANTIZED: return lo + *p++ * step;
+        default: return 1.0;
+        }
+    }
+};
+
+// Builds the byte stream from an edge stream without materialising a graph: one pass
+// counts degrees and weights, then each further pass stages (target, weight code) pairs,
+// 8 bytes each, for a slice of vertices holding at most budget_entries adjacency entries,
+// sorts and encodes them. Peak memory is the output plus ~20 B/vertex plus the budget.
+// Undirected edges go into both endpoint lists (self-loops once), as in BasicGraph.
+CompressedAdjacency compress_stream(size_t n, bool directed, const EdgeScan& scan, WeightCoding coding,
+                                    size_t budget_entries);
+
+// In-memory edge list: a single slice.
+CompressedAdjacency compress_adjacency(size_t n, const std::vector<EdgeRecord>& edges, bool directed,
+                                       WeightCoding coding);
+
+} // namespace detail
+
+// Adjacency entry decoded on the fly. Edge ids are not stored.
+struct CompressedEdge {
+    int to;
+    double w;
+
+    double weight() const { return w; }
+};
+
+// One decoded adjacency list; iterating walks the byte stream forward.
+class CompressedNeighbors {
+public:
+    class iterator {
+    public:
+        iterator(const detail::CompressedAdjacency* a, const uint8_t* p, size_t left)
+            : _a(a), _p(p), _left(left), _e{0, 1.0} {
+            if (_left) decode();
+        }
+        const CompressedEdge& operator*() const { return _e; }
+        const CompressedEdge* operator->() const { return &_e; }
+        iterator& operator++() {
+            if (--_left) decode();
+            return *this;
+        }
+        bool operator!=(const iterator& o) const { return _left != o._left; }
+        bool operator==(const iterator& o) const { return _left == o._left; }
+
+    private:
+        const detail::CompressedAdjacency* _a;
+        const uint8_t* _p;
+        size_t _left;
+        CompressedEdge _e;
+
+        void decode() {
+            _e.to += static_cast<int>(detail::get_varint(_p));
+            _e.w = _a->get_weight(_p);
+        }
+    };
+
+    CompressedNeighbors(const detail::CompressedAdjacency* a, const uint8_t* p, size_t size)
+        : _a(a), _p(p), _size(size) {}
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    iterator begin() const { return iterator(_a, _p, _size); }
+    iterator end() const { return iterator(_a, _p, 0); }
+
+private:
+    const detail::CompressedAdjacency* _a;
+    const uint8_t* _p;
+    size_t _size;
+};
+
+// Read-only, gap-encoded copy of a BasicGraph with the same traversal interface
+// (vertex_count, neighbors, degrees), so templated algorithms run on it unchanged.
+// Neighbours come back sorted by target rather than in insertion order.
+template <typename Direction>
+class BasicCompressedGraph {
+public:
+    using direction_type = Direction;
+
+    static constexpr bool is_directed = Direction::directed;
+
+    template <typename W>
+    explicit BasicCompressedGraph(const BasicGraph<Direction, W>& g, WeightCoding c = WeightCoding::NONE)
+        : _a(detail::compress_adjacency(g.vertex_count(), g.edges(), is_directed,
+                                        BasicGraph<Direction, W>::is_weighted ? c : WeightCoding::NONE)) {}
+
+    explicit BasicCompressedGraph(detail::CompressedAdjacency a) : _a(std::move(a)) {}
+
+    size_t vertex_count() const { return _a.off.size() - 1; }
+    size_t edge_count() const { return _a.edge_count; }
+    WeightCoding weight_coding() const { return _a.coding; }
+
+    CompressedNeighbors neighbors(int u) const {
+        const uint8_t* p = list(u);
+        size_t d = detail::get_varint(p);
+        return CompressedNeighbors(&_a, p, d);
+    }
+
+    int out_degree(int u) const {
+        const uint8_t* p = list(u);
+        return static_cast<int>(detail::get_varint(p));
+    }
+
+    int in_degree(int u) const {
+        if constexpr (is_directed) {
+            validate_vertex(u);
+            return _a.in_deg[u];
+        } else {
+            return out_degree(u);
+        }
+    }
+
+    int degree(int u) const { return out_degree(u); }
+
+    // Heap bytes held by the representation.
+    size_t memory_bytes() const {
+        return _a.off.capacity() * sizeof(uint64_t) + _a.bytes.capacity() +
+               _a.in_deg.capacity() * sizeof(int) + _a.dict.capacity() * sizeof(double);
+    }
+
+    void validate_vertex(int u) const {
+        if (u < 0 || static_cast<size_t>(u) >= vertex_count())
+            throw std::out_of_range("Invalid vertex: " + std::to_string(u));
+    }
+
+private:
+    detail::CompressedAdjacency _a;
+
+    const uint8_t* list(int u) const {
+        validate_vertex(u);
+        return _a.bytes.data() + _a.off[u];
+    }
+};
+
+// Runtime-typed counterpart of Graph; use visit() to reach the concrete flavour.
+class CompressedGraph {
+public:
+    using Storage = std::variant<BasicCompressedGraph<Undirected>, BasicCompressedGraph<Directed>>;
+
+    // Staged entries per pass for the streaming builders (8 bytes each: 512 MiB).
+    static constexpr size_t DEFAULT_BUDGET = size_t(1) << 26;
+
+    explicit CompressedGraph(const Graph& g, WeightCoding c = WeightCoding::NONE);
+
+    // Streams a part_1 graph file ("U|D n m" header, then "u v [w]" lines) straight into
+    // the compressed form; the file is read once plus once per vertex slice.
+    static CompressedGraph from_file(const std::string& path, WeightCoding c = WeightCoding::NONE,
+                                     size_t budget_entries = DEFAULT_BUDGET);
+
+    // Same from any replayable edge source, e.g. edge chunks on disk.
+    static CompressedGraph from_edges(size_t n, GraphType t, const EdgeScan& scan,
+                                      WeightCoding c = WeightCoding::NONE,
+                                      size_t budget_entries = DEFAULT_BUDGET);
+
+    template <typename F>
+    decltype(auto) visit(F&& f) const { return std::visit(std::forward<F>(f), _g); }
+
+    size_t vertex_count() const { return visit([](const auto& g) { return g.vertex_count(); }); }
+    size_t edge_count() const { return visit([](const auto& g) { return g.edge_count(); }); }
+    size_t memory_bytes() const { return visit([](const auto& g) { return g.memory_bytes(); }); }
+    bool directed() const { return _g.index() == 1; }
+
+private:
+    Storage _g;
+
+    explicit CompressedGraph(Storage g) : _g(std::move(g)) {}
+};
+
+} // namespace osproj
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "graph.hpp"
+
+namespace osproj {
+
+// Uniform random graph G(n, m): m edges with endpoints drawn independently
+// (self-loops and parallel edges possible), integer weights in [1, max_w].
+Graph random_gnm(size_t n, size_t m, unsigned seed,
+                 GraphType t = GraphType::UNDIRECTED, int max_w = 1);
+
+// rows x cols undirected grid (4-neighbourhood), integer weights in [1, max_w].
+Graph random_grid(size_t rows, size_t cols, unsigned seed, int max_w = 1);
+
+} // namespace osproj
@@ -5,52 +5,84 @@
 #include <stdexcept>
 #include <iostream>
 #include <limits>
+#include <variant>
+
+#include "basic_graph.hpp"
 
 namespace osproj {
 
 enum class GraphType { DIRECTED, UNDIRECTED };
 
-struct Edge {
-    int to;
-    int id;
-    double w;
-};
+// Read-only view of one adjacency list that yields Edge values whatever the
+// underlying flavour (unweighted entries report w = 1).
+class NeighborRange {
+public:
+    class iterator {
+    public:
+        iterator(const NeighborRange* r, size_t i) : _r(r), _i(i) {}
+        Edge operator*() const { return (*_r)[_i]; }
+        iterator& operator++() { ++_i; return *this; }
+        bool operator!=(const iterator& o) const { return _i != o._i; }
+        bool operator==(const iterator& o) const { return _i == o._i; }
+
+    private:
+        const NeighborRange* _r;
+        size_t _i;
+    };
+
+    explicit NeighborRange(const std::vector<BasicEdge<void>>& v) : _plain(v.data()), _size(v.size()) {}
+    explicit NeighborRange(const std::vector<Edge>& v) : _weighted(v.data()), _size(v.size()) {}
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    Edge operator[](size_t i) const {
+        if (_weighted) return _weighted[i];
+        return {_plain[i].to, _plain[i].id, 1.0};
+    }
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, _size); }
 
-struct EdgeRecord {
-    int id;
-    int u, v;
-    double w;
+private:
+    const BasicEdge<void>* _plain = nullptr;
+    const Edge* _weighted = nullptr;
+    size_t _size = 0;
 };
 
+// Runtime-typed graph: holds one of the four BasicGraph flavours. A graph starts
+// unweighted and switches to the weighted flavour on the first weight other than 1.
+// Hot loops should call visit() once and run on the concrete BasicGraph.
 class Graph {
 public:
+    using Storage = std::variant<BasicGraph<Undirected, void>, BasicGraph<Undirected, double>,
+                                 BasicGraph<Directed, void>, BasicGraph<Directed, double>>;
+
     explicit Graph(size_t n = 0, GraphType t = GraphType::UNDIRECTED);
 
+    // Calls f with the concrete BasicGraph.
+    template <typename F>
+    decltype(auto) visit(F&& f) const { return std::visit(std::forward<F>(f), _g); }
+
     void resize(size_t n);
     int add_vertex();
     void add_edge(int u, int v, double w = 1.0);
 
-    size_t vertex_count() const { return _n; }
-    size_t edge_count() const { return _edges.size(); }
+    size_t vertex_count() const { return visit([](const auto& g) { return g.vertex_count(); }); }
+    size_t edge_count() const { return edges().size(); }
 
     bool directed() const { return _type == GraphType::DIRECTED; }
+    bool weighted() const { return _g.index() % 2 == 1; }
     GraphType type() const { return _type; }
 
-    const std::vector<Edge>& neighbors(int u) const;
-
-    int out_degree(int u) const {
-        validate_vertex(u);
-        return _outdeg[u];
+    NeighborRange neighbors(int u) const {
+        return visit([u](const auto& g) { return NeighborRange(g.neighbors(u)); });
     }
-
-    int in_degree(int u) const {
-        validate_vertex(u);
-        return _indeg[u];
+    const std::vector<EdgeRecord>& edges() const {
+        return visit([](const auto& g) -> const std::vector<EdgeRecord>& { return g.edges(); });
     }
 
-    int degree(int u) const {
-        return directed() ? out_degree(u) : out_degree(u);
-    }
+    int out_degree(int u) const { return visit([u](const auto& g) { return g.out_degree(u); }); }
+    int in_degree(int u) const { return visit([u](const auto& g) { return g.in_degree(u); }); }
+    int degree(int u) const { return out_degree(u); }
 
     static Graph from_file(const std::string& path);
     static Graph from_stream(std::istream& in);
@@ -62,16 +94,10 @@ public:
     }
 
 private:
-    size_t _n{};
     GraphType _type{GraphType::UNDIRECTED};
-    std::vector<std::vector<Edge>> _adj;
-    std::vector<EdgeRecord> _edges;
-    std::vector<int> _indeg, _outdeg;
+    Storage _g;
 
-    void validate_vertex(int u) const {
-        if (u < 0 || static_cast<size_t>(u) >= _n)
-            throw std::out_of_range("Invalid vertex: " + std::to_string(u));
-    }
+    void make_weighted();
 };
 
 } // namespace osproj
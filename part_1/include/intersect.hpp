@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osproj {
+
+// Sorted-set intersection kernels over strictly increasing int arrays.
+enum class IntersectKernel {
+    AUTO,   // scalar for tiny lists, galloping for very skewed sizes, SIMD otherwise
+    SCALAR, // branchy two-pointer merge
+    GALLOP, // exponential + binary search of the smaller list in the larger one
+    SIMD    // block all-pairs compare: AVX2 or SSE2, picked at runtime; scalar elsewhere
+};
+
+// Size of a ∩ b.
+size_t intersect_count(const int* a, size_t na, const int* b, size_t nb,
+                       IntersectKernel k = IntersectKernel::AUTO);
+
+// Writes a ∩ b to out (room for min(na, nb) values) and returns its size.
+size_t intersect_into(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+// Instruction set the SIMD kernel dispatches to: "avx2", "sse2" or "scalar".
+const char* simd_level();
+
+} // namespace osproj
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "graph.hpp"
+
+namespace osproj {
+
+struct MaxFlowResult {
+    double value = 0;             // maximum s-t flow = minimum cut capacity
+    std::vector<int> source_side; // vertices on the s side of a minimum cut, ascending
+};
+
+// FIFO push-relabel with global relabeling and the gap heuristic over a flat residual
+// graph built from the edge list. Edge weights are capacities; an undirected edge gives
+// capacity w in both directions. Only the preflow phase runs: it already fixes the flow
+// value and the cut, so no flow is returned to the source.
+MaxFlowResult max_flow(size_t n, const std::vector<EdgeRecord>& edges, bool directed, int s, int t);
+
+inline MaxFlowResult max_flow(const Graph& g, int s, int t) {
+    return max_flow(g.vertex_count(), g.edges(), g.directed(), s, t);
+}
+
+} // namespace osproj
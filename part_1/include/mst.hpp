@@ -0,0 +1,23 @@
+#pragma once
+
+#include "graph.hpp"
+
+namespace osproj {
+
+struct MstResult {
+    double weight = 0;     // total weight of the spanning forest
+    std::vector<int> edges; // selected EdgeRecord ids, ascending
+};
+
+// Both engines treat edges as undirected, skip self-loops and break weight ties by
+// edge id, so they select the same minimum spanning forest.
+// threads == 0 means std::thread::hardware_concurrency().
+
+// Kruskal baseline: parallel chunked sort of the edge list, then a sequential union-find sweep.
+MstResult mst_kruskal(size_t n, const std::vector<EdgeRecord>& edges, unsigned threads = 0);
+
+// Parallel Boruvka: every round each component picks its lightest outgoing edge with a
+// lock-free CAS, then components are hooked through a concurrent union-find.
+MstResult mst_boruvka(size_t n, const std::vector<EdgeRecord>& edges, unsigned threads = 0);
+
+} // namespace osproj
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "graph.hpp"
+
+namespace osproj {
+
+enum class Ordering {
+    RCM,    // reverse Cuthill-McKee: small bandwidth, neighbours get nearby ids
+    DEGREE, // descending degree: hubs packed together at the front
+    BFS     // breadth-first discovery order, one component after another
+};
+
+// A relabeled copy of a graph plus the maps needed to translate results back.
+struct Reordered {
+    Graph graph;
+    std::vector<int> old_id;   // new vertex -> original vertex
+    std::vector<int> new_id;   // original vertex -> new vertex
+    std::vector<int> old_edge; // new EdgeRecord id -> original EdgeRecord id
+
+    int to_old(int v) const { return old_id.at(v); }
+    std::vector<int> to_old(const std::vector<int>& vs) const;
+};
+
+// New position -> original vertex for the requested ordering. Direction is ignored.
+std::vector<int> compute_ordering(const Graph& g, Ordering o);
+
+// Renumbers vertices so that old_id[i] becomes vertex i, and edges so that they are
+// grouped by their new source vertex (then target); edge direction is preserved.
+Reordered relabel(const Graph& g, std::vector<int> old_id);
+
+inline Reordered reorder(const Graph& g, Ordering o) {
+    return relabel(g, compute_ordering(g, o));
+}
+
+} // namespace osproj
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "graph.hpp"
+#include "intersect.hpp"
+#include <cstdint>
+
+namespace osproj {
+
+// Simple undirected view of a graph in CSR form: self-loops and parallel edges
+// dropped, edge direction ignored, every neighbour list sorted ascending.
+struct SortedAdjacency {
+    std::vector<int> off, adj;
+
+    size_t vertex_count() const { return off.empty() ? 0 : off.size() - 1; }
+    const int* begin(int u) const { return adj.data() + off[u]; }
+    size_t degree(int u) const { return static_cast<size_t>(off[u + 1] - off[u]); }
+};
+
+SortedAdjacency sorted_adjacency(const Graph& g);
+
+// Number of triangles in the simple undirected view. Vertices are ranked by degree and
+// each edge is kept only towards the higher rank, so every triangle is found once by
+// intersecting two short forward lists. High-degree vertices use a bitset probe instead.
+// k forces one intersection kernel (for benchmarks); AUTO picks per pair.
+uint64_t count_triangles(const Graph& g, IntersectKernel k = IntersectKernel::AUTO);
+uint64_t count_triangles(const SortedAdjacency& a, IntersectKernel k = IntersectKernel::AUTO);
+
+struct CliqueEstimate {
+    std::vector<int> clique; // a clique found greedily (lower bound), ascending
+    int upper_bound = 0;     // degeneracy + 1
+};
+
+// Max-clique estimate: greedy growth inside each vertex's forward neighbourhood in
+// degeneracy order, skipping vertices whose core number cannot beat the best so far.
+CliqueEstimate max_clique_estimate(const Graph& g);
+
+} // namespace osproj
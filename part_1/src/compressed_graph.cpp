@@ -0,0 +1,199 @@
+#include "../include/compressed_graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+using namespace osproj;
+
+namespace {
+
+// Maps a weight to the code stored after its gap; the decoding tables live in the
+// CompressedAdjacency itself.
+struct WeightEncoder {
+    std::unordered_map<double, uint32_t> index; // DICTIONARY
+
+    uint32_t code(const detail::CompressedAdjacency& a, double w) const {
+        if (a.coding == WeightCoding::DICTIONARY) return index.at(w);
+        if (a.coding == WeightCoding::QUANTIZED) {
+            long q = a.step > 0 ? std::lround((w - a.lo) / a.step) : 0;
+            return static_cast<uint32_t>(std::clamp(q, 0L, 255L));
+        }
+        return 0;
+    }
+
+    static void put(detail::CompressedAdjacency& a, uint32_t code) {
+        if (a.coding == WeightCoding::DICTIONARY) detail::put_varint(a.bytes, code);
+        else if (a.coding == WeightCoding::QUANTIZED) a.bytes.push_back(static_cast<uint8_t>(code));
+    }
+};
+
+// Weight statistics gathered in the counting pass.
+struct WeightStats {
+    std::unordered_map<double, size_t> freq; // DICTIONARY
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -std::numeric_limits<double>::infinity();
+
+    void add(WeightCoding c, double w) {
+        if (c == WeightCoding::DICTIONARY) {
+            freq[w]++;
+        } else if (c == WeightCoding::QUANTIZED) {
+            lo = std::min(lo, w);
+            hi = std::max(hi, w);
+        }
+    }
+};
+
+// Fills the decoding tables of a and returns the matching encoder.
+WeightEncoder build_weights(detail::CompressedAdjacency& a, const WeightStats& st) {
+    WeightEncoder enc;
+    if (a.coding == WeightCoding::DICTIONARY) {
+        std::vector<std::pair<double, size_t>> byfreq(st.freq.begin(), st.freq.end());
+        std::sort(byfreq.begin(), byfreq.end(), [](const auto& x, const auto& y) {
+            return x.second > y.second || (x.second == y.second && x.first < y.first);
+        });
+        for (const auto& [w, count] : byfreq) {
+            (void)count;
+            enc.index[w] = static_cast<uint32_t>(a.dict.size());
+            a.dict.push_back(w);
+        }
+    } else if (a.coding == WeightCoding::QUANTIZED && st.lo <= st.hi) {
+        a.lo = st.lo;
+        a.step = (st.hi - st.lo) / 255.0;
+    }
+    return enc;
+}
+
+struct FileHeader {
+    char type;
+    size_t n, m;
+};
+
+// Same format and messages as Graph::from_stream.
+FileHeader read_header(std::istream& in) {
+    FileHeader h;
+    if (!(in >> h.type >> h.n >> h.m))
+        throw std::runtime_error("Invalid header line (expected: TYPE N M)");
+    return h;
+}
+
+void read_edges(std::istream& in, size_t m, const EdgeSink& emit) {
+    for (size_t i = 0; i < m; ++i) {
+        int u, v;
+        double w = 1.0;
+        if (!(in >> u >> v)) throw std::runtime_error("Invalid edge line");
+        if (in.peek() == ' ' || in.peek() == '\t') {
+            if (!(in >> w)) w = 1.0;
+        }
+        emit(u, v, w);
+    }
+}
+
+} // namespace
+
+detail::CompressedAdjacency detail::compress_stream(size_t n, bool directed, const EdgeScan& scan,
+                                                    WeightCoding coding, size_t budget_entries) {
+    CompressedAdjacency a;
+    a.coding = coding;
+    if (directed) a.in_deg.assign(n, 0);
+
+    auto check = [n](int v) {
+        if (v < 0 || static_cast<size_t>(v) >= n)
+            throw std::out_of_range("Invalid vertex: " + std::to_string(v));
+    };
+
+    // Pass 1: list lengths and weight statistics.
+    std::vector<uint32_t> deg(n, 0);
+    WeightStats stats;
+    scan([&](int u, int v, double w) {
+        check(u);
+        check(v);
+        a.edge_count++;
+        deg[u]++;
+        if (directed) a.in_deg[v]++;
+        else if (u != v) deg[v]++;
+        stats.add(coding, w);
+    });
+    WeightEncoder enc = build_weights(a, stats);
+
+    // One more pass per slice of consecutive vertices whose lists fit in the budget.
+    budget_entries = std::max<size_t>(budget_entries, 1);
+    a.off.resize(n + 1);
+    std::vector<std::pair<int, uint32_t>> staged; // (target, weight code)
+    std::vector<size_t> pos;
+    for (size_t lo = 0; lo < n;) {
+        size_t hi = lo, total = 0;
+        while (hi < n && (hi == lo || total + deg[hi] <= budget_entries)) total += deg[hi++];
+
+        pos.assign(hi - lo + 1, 0);
+        for (size_t x = lo; x < hi; ++x) pos[x - lo + 1] = pos[x - lo] + deg[x];
+        staged.resize(total);
+        std::vector<size_t> fill(pos.begin(), pos.end() - 1);
+        auto in_slice = [lo, hi](int v) { return static_cast<size_t>(v) >= lo && static_cast<size_t>(v) < hi; };
+        scan([&](int u, int v, double w) {
+            bool su = in_slice(u), sv = !directed && u != v && in_slice(v);
+            if (!su && !sv) return;
+            uint32_t code = enc.code(a, w);
+            if (su) staged[fill[u - lo]++] = {v, code};
+            if (sv) staged[fill[v - lo]++] = {u, code};
+        });
+
+        for (size_t x = lo; x < hi; ++x) {
+            a.off[x] = a.bytes.size();
+            auto first = staged.begin() + pos[x - lo], last = staged.begin() + pos[x - lo + 1];
+            std::sort(first, last);
+            put_varint(a.bytes, deg[x]);
+            int prev = 0;
+            for (auto it = first; it != last; ++it) {
+                put_varint(a.bytes, static_cast<uint32_t>(it->first - prev));
+                WeightEncoder::put(a, it->second);
+                prev = it->first;
+            }
+        }
+        lo = hi;
+    }
+    a.off[n] = a.bytes.size();
+    a.bytes.shrink_to_fit();
+    return a;
+}
+
+detail::CompressedAdjacency detail::compress_adjacency(size_t n, const std::vector<EdgeRecord>& edges,
+                                                       bool directed, WeightCoding coding) {
+    EdgeScan scan = [&edges](const EdgeSink& emit) {
+        for (const auto& e : edges) emit(e.u, e.v, e.w);
+    };
+    return compress_stream(n, directed, scan, coding, std::numeric_limits<size_t>::max());
+}
+
+static CompressedGraph::Storage compress(const Graph& g, WeightCoding c) {
+    return g.visit([c](const auto& bg) -> CompressedGraph::Storage {
+        using G = std::decay_t<decltype(bg)>;
+        return BasicCompressedGraph<typename G::direction_type>(bg, c);
+    });
+}
+
+CompressedGraph::CompressedGraph(const Graph& g, WeightCoding c) : _g(compress(g, c)) {}
+
+CompressedGraph CompressedGraph::from_edges(size_t n, GraphType t, const EdgeScan& scan, WeightCoding c,
+                                            size_t budget_entries) {
+    bool directed = t == GraphType::DIRECTED;
+    detail::CompressedAdjacency a = detail::compress_stream(n, directed, scan, c, budget_entries);
+    if (directed) return CompressedGraph(Storage(BasicCompressedGraph<Directed>(std::move(a))));
+    return CompressedGraph(Storage(BasicCompressedGraph<Undirected>(std::move(a))));
+}
+
+CompressedGraph CompressedGraph::from_file(const std::string& path, WeightCoding c, size_t budget_entries) {
+    std::ifstream fin(path);
+    if (!fin)
+        throw std::runtime_error("Failed to open file: " + path);
+    FileHeader h = read_header(fin);
+    EdgeScan scan = [&path, m = h.m](const EdgeSink& emit) {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error("Failed to open file: " + path);
+        read_header(in);
+        read_edges(in, m, emit);
+    };
+    return from_edges(h.n, h.type == 'D' ? GraphType::DIRECTED : GraphType::UNDIRECTED, scan, c, budget_entries);
+}
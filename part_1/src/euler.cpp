@@ -1,4 +1,5 @@
 #include "../include/graph.hpp"
+#include "../include/compressed_graph.hpp"
 #include <stack>
 #include <vector>
 #include <iostream>
@@ -8,21 +9,21 @@
 
 using namespace osproj;
 
-// Returns Eulerian circuit or empty vector if none exists
-std::vector<int> find_euler_circuit(const Graph& g) {
-    if (g.directed()) {
-        for (size_t i = 0; i < g.vertex_count(); ++i) {
+namespace {
+
+template <typename G>
+std::vector<int> euler_circuit(const G& g) {
+    for (size_t i = 0; i < g.vertex_count(); ++i) {
+        if constexpr (G::is_directed) {
             if (g.in_degree(i) != g.out_degree(i)) return {};
-        }
-    } else {
-        for (size_t i = 0; i < g.vertex_count(); ++i) {
+        } else {
             if (g.degree(i) % 2 != 0) return {};
         }
     }
 
     std::unordered_map<int, std::multiset<int>> adj;
     for (size_t u = 0; u < g.vertex_count(); ++u) {
-        for (auto& e : g.neighbors(u)) {
+        for (const auto& e : g.neighbors(u)) {
             adj[u].insert(e.to);
         }
     }
@@ -36,7 +37,7 @@ std::vector<int> find_euler_circuit(const Graph& g) {
         if (!adj[u].empty()) {
             int v = *adj[u].begin();
             adj[u].erase(adj[u].begin());
-            if (!g.directed()) {
+            if constexpr (!G::is_directed) {
                 adj[v].erase(adj[v].find(u));
             }
             st.push(v);
@@ -53,3 +54,15 @@ std::vector<int> find_euler_circuit(const Graph& g) {
     std::reverse(circuit.begin(), circuit.end());
     return circuit;
 }
+
+} // namespace
+
+// Returns Eulerian circuit or empty vector if none exists
+std::vector<int> find_euler_circuit(const Graph& g) {
+    return g.visit([](const auto& bg) { return euler_circuit(bg); });
+}
+
+// Same algorithm, decoding the neighbour lists straight from the compressed stream
+std::vector<int> find_euler_circuit(const CompressedGraph& g) {
+    return g.visit([](const auto& cg) { return euler_circuit(cg); });
+}
@@ -0,0 +1,34 @@
+#include "../include/generators.hpp"
+#include <random>
+#include <algorithm>
+
+using namespace osproj;
+
+Graph osproj::random_gnm(size_t n, size_t m, unsigned seed, GraphType t, int max_w) {
+    if (n == 0 && m > 0)
+        throw std::invalid_argument("random_gnm: edges requested on an empty graph");
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> vert(0, n ? n - 1 : 0);
+    std::uniform_int_distribution<int> weight(1, std::max(1, max_w));
+    Graph g(n, t);
+    for (size_t i = 0; i < m; ++i) {
+        int u = static_cast<int>(vert(rng));
+        int v = static_cast<int>(vert(rng));
+        g.add_edge(u, v, weight(rng));
+    }
+    return g;
+}
+
+Graph osproj::random_grid(size_t rows, size_t cols, unsigned seed, int max_w) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weight(1, std::max(1, max_w));
+    Graph g(rows * cols, GraphType::UNDIRECTED);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            int u = static_cast<int>(r * cols + c);
+            if (c + 1 < cols) g.add_edge(u, u + 1, weight(rng));
+            if (r + 1 < rows) g.add_edge(u, u + static_cast<int>(cols), weight(rng));
+        }
+    }
+    return g;
+}
@@ -6,44 +6,39 @@
 using namespace osproj;
 
 // Constructor
-Graph::Graph(size_t n, GraphType t) : _n(n), _type(t), _adj(n), _indeg(n, 0), _outdeg(n, 0) {}
+Graph::Graph(size_t n, GraphType t) : _type(t) {
+    if (t == GraphType::DIRECTED) _g.emplace<BasicGraph<Directed, void>>(n);
+    else _g.emplace<BasicGraph<Undirected, void>>(n);
+}
 
 // Resize
 void Graph::resize(size_t n) {
-    _n = n;
-    _adj.resize(n);
-    _indeg.resize(n, 0);
-    _outdeg.resize(n, 0);
-    _edges.clear();
+    std::visit([n](auto& g) { g.resize(n); }, _g);
 }
 
 // Add vertex
 int Graph::add_vertex() {
-    _adj.emplace_back();
-    _indeg.push_back(0);
-    _outdeg.push_back(0);
-    return _n++;
+    return std::visit([](auto& g) { return g.add_vertex(); }, _g);
 }
 
 // Add edge
 void Graph::add_edge(int u, int v, double w) {
-    validate_vertex(u);
-    validate_vertex(v);
-    int id = static_cast<int>(_edges.size());
-    _edges.push_back({id, u, v, w});
-    _adj[u].push_back({v, id, w});
-    _outdeg[u]++;
-    _indeg[v]++;
-    if (_type == GraphType::UNDIRECTED && u != v) {
-        _adj[v].push_back({u, id, w});
-        _outdeg[v]++;
-        _indeg[u]++;
-    }
+    if (w != 1.0 && !weighted()) make_weighted();
+    std::visit([&](auto& g) {
+        if constexpr (std::decay_t<decltype(g)>::is_weighted) g.add_edge(u, v, w);
+        else g.add_edge(u, v);
+    }, _g);
 }
 
-const std::vector<Edge>& Graph::neighbors(int u) const {
-    validate_vertex(u);
-    return _adj[u];
+// Switch to the weighted flavour, replaying the edge list so ids and adjacency order are kept.
+void Graph::make_weighted() {
+    std::visit([this](const auto& g) {
+        using G = std::decay_t<decltype(g)>;
+        BasicGraph<typename G::direction_type, double> wg(g.vertex_count());
+        wg.reserve_edges(g.edge_count());
+        for (const auto& e : g.edges()) wg.add_edge(e.u, e.v, e.w);
+        _g = std::move(wg);
+    }, Storage(std::move(_g)));
 }
 
 // Load from file
@@ -76,8 +71,8 @@ Graph Graph::from_stream(std::istream& in) {
 
 // Write to stream
 void Graph::to_stream(std::ostream& out) const {
-    out << (directed() ? 'D' : 'U') << ' ' << _n << ' ' << _edges.size() << '\n';
-    for (const auto& e : _edges) {
+    out << (directed() ? 'D' : 'U') << ' ' << vertex_count() << ' ' << edge_count() << '\n';
+    for (const auto& e : edges()) {
         out << e.u << ' ' << e.v;
         if (e.w != 1.0)
             out << ' ' << e.w;
@@ -0,0 +1,131 @@
+#include "../include/intersect.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define OSPROJ_X86 1
+#endif
+
+using namespace osproj;
+
+namespace {
+
+// Below this the SIMD blocks never fill and the kernel ends up in its scalar tail anyway.
+const size_t SIMD_MIN_SIZE = 8;
+
+size_t merge_count(const int* a, size_t na, const int* b, size_t nb) {
+    size_t i = 0, j = 0, c = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) ++i;
+        else if (a[i] > b[j]) ++j;
+        else { ++c; ++i; ++j; }
+    }
+    return c;
+}
+
+// a is the smaller list; every probe restarts from the last match position in b.
+size_t gallop_count(const int* a, size_t na, const int* b, size_t nb) {
+    size_t c = 0, lo = 0;
+    for (size_t i = 0; i < na && lo < nb; ++i) {
+        size_t step = 1, hi = lo;
+        while (hi < nb && b[hi] < a[i]) { lo = hi + 1; hi += step; step <<= 1; }
+        const int* p = std::lower_bound(b + lo, b + std::min(hi + 1, nb), a[i]);
+        lo = static_cast<size_t>(p - b);
+        if (lo < nb && b[lo] == a[i]) { ++c; ++lo; }
+    }
+    return c;
+}
+
+#ifdef OSPROJ_X86
+// Compares a 4-block of a against all rotations of a 4-block of b, then advances
+// whichever block has the smaller maximum (both on a tie).
+size_t sse2_count(const int* a, size_t na, const int* b, size_t nb) {
+    size_t i = 0, j = 0, c = 0;
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+        c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(m)));
+        int amax = a[i + 3], bmax = b[j + 3];
+        if (amax <= bmax) i += 4;
+        if (bmax <= amax) j += 4;
+    }
+    return c + merge_count(a + i, na - i, b + j, nb - j);
+}
+
+__attribute__((target("avx2")))
+size_t avx2_count(const int* a, size_t na, const int* b, size_t nb) {
+    const __m256i rot = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    size_t i = 0, j = 0, c = 0;
+    while (i + 8 <= na && j + 8 <= nb) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i m = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rot);
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vb));
+        }
+        c += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+        int amax = a[i + 7], bmax = b[j + 7];
+        if (amax <= bmax) i += 8;
+        if (bmax <= amax) j += 8;
+    }
+    return c + sse2_count(a + i, na - i, b + j, nb - j);
+}
+#endif
+
+using CountFn = size_t (*)(const int*, size_t, const int*, size_t);
+
+struct Dispatch {
+    CountFn fn = merge_count;
+    const char* name = "scalar";
+    Dispatch() {
+#ifdef OSPROJ_X86
+        fn = sse2_count;
+        name = "sse2";
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            fn = avx2_count;
+            name = "avx2";
+        }
+#endif
+    }
+};
+
+const Dispatch& dispatch() {
+    static const Dispatch d;
+    return d;
+}
+
+} // namespace
+
+size_t osproj::intersect_count(const int* a, size_t na, const int* b, size_t nb, IntersectKernel k) {
+    if (na > nb) { std::swap(a, b); std::swap(na, nb); }
+    if (na == 0) return 0;
+    switch (k) {
+    case IntersectKernel::SCALAR: return merge_count(a, na, b, nb);
+    case IntersectKernel::GALLOP: return gallop_count(a, na, b, nb);
+    case IntersectKernel::SIMD:   return dispatch().fn(a, na, b, nb);
+    case IntersectKernel::AUTO:   break;
+    }
+    if (nb < SIMD_MIN_SIZE) return merge_count(a, na, b, nb);
+    if (na * 32 < nb) return gallop_count(a, na, b, nb);
+    return dispatch().fn(a, na, b, nb);
+}
+
+size_t osproj::intersect_into(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, c = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) ++i;
+        else if (a[i] > b[j]) ++j;
+        else { out[c++] = a[i]; ++i; ++j; }
+    }
+    return c;
+}
+
+const char* osproj::simd_level() {
+    return dispatch().name;
+}
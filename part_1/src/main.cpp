@@ -1,28 +1,108 @@
 #include "../include/graph.hpp"
+#include "../include/mst.hpp"
+#include "../include/maxflow.hpp"
+#include "../include/triangles.hpp"
+#include "../include/reorder.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <string>
+#include <optional>
+#include <algorithm>
+#include <unistd.h>
 
 extern std::vector<int> find_euler_circuit(const osproj::Graph&);
 
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [-r rcm|degree|bfs] <graph_file>"
+                 " [EULER | MST | MAX_FLOW <s> <t> | TRIANGLES | MAX_CLIQUE]\n"
+                 "  -r  relabel vertices for cache locality first (results use the original ids)\n";
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <graph_file>\n";
+    std::optional<osproj::Ordering> ordering;
+    int opt;
+    while ((opt = getopt(argc, argv, "r:")) != -1) {
+        std::string arg = optarg ? optarg : "";
+        if (opt == 'r' && arg == "rcm") ordering = osproj::Ordering::RCM;
+        else if (opt == 'r' && arg == "degree") ordering = osproj::Ordering::DEGREE;
+        else if (opt == 'r' && arg == "bfs") ordering = osproj::Ordering::BFS;
+        else { usage(argv[0]); return 1; }
+    }
+    int nargs = argc - optind;
+    char** args = argv + optind;
+    if (nargs < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    std::string algo = nargs >= 2 ? args[1] : "EULER";
+    int want_args = algo == "MAX_FLOW" ? 4 : (nargs >= 2 ? 2 : 1);
+    if (nargs != want_args) {
+        usage(argv[0]);
         return 1;
     }
 
     try {
-        osproj::Graph g = osproj::Graph::from_file(argv[1]);
+        osproj::Graph orig = osproj::Graph::from_file(args[0]);
+        std::optional<osproj::Reordered> re;
+        if (ordering) re = osproj::reorder(orig, *ordering);
+        const osproj::Graph& g = re ? re->graph : orig;
+        auto to_orig = [&](std::vector<int> vs) {
+            if (re) vs = re->to_old(vs);
+            return vs;
+        };
 
-        std::vector<int> circuit = find_euler_circuit(g);
+        if (algo == "EULER") {
+            std::vector<int> circuit = to_orig(find_euler_circuit(g));
 
-        if (circuit.empty()) {
-            std::cout << "No Eulerian circuit exists.\n";
-        } else {
-            std::cout << "Eulerian circuit: ";
-            for (int v : circuit)
-                std::cout << v << ' ';
+            if (circuit.empty()) {
+                std::cout << "No Eulerian circuit exists.\n";
+            } else {
+                std::cout << "Eulerian circuit: ";
+                for (int v : circuit)
+                    std::cout << v << ' ';
+                std::cout << '\n';
+            }
+        } else if (algo == "MST") {
+            osproj::MstResult mst = osproj::mst_boruvka(g.vertex_count(), g.edges());
+            std::cout << "Minimum spanning forest weight: " << mst.weight << '\n';
+            std::cout << "Edges:";
+            std::vector<int> ids = mst.edges;
+            if (re) {
+                for (int& id : ids) id = re->old_edge[id];
+                std::sort(ids.begin(), ids.end());
+            }
+            for (int id : ids)
+                std::cout << ' ' << orig.edges()[id].u << '-' << orig.edges()[id].v;
+            std::cout << '\n';
+        } else if (algo == "MAX_FLOW") {
+            int s = std::stoi(args[2]), t = std::stoi(args[3]);
+            if (re) {
+                s = re->new_id.at(s);
+                t = re->new_id.at(t);
+            }
+            osproj::MaxFlowResult mf = osproj::max_flow(g, s, t);
+            std::vector<int> side = to_orig(mf.source_side);
+            std::sort(side.begin(), side.end());
+            std::cout << "Max flow: " << mf.value << '\n';
+            std::cout << "Min cut source side:";
+            for (int v : side)
+                std::cout << ' ' << v;
             std::cout << '\n';
+        } else if (algo == "TRIANGLES") {
+            std::cout << "Triangles: " << osproj::count_triangles(g) << '\n';
+        } else if (algo == "MAX_CLIQUE") {
+            osproj::CliqueEstimate est = osproj::max_clique_estimate(g);
+            std::cout << "Max clique: >= " << est.clique.size() << ", <= " << est.upper_bound << '\n';
+            std::cout << "Clique:";
+            std::vector<int> clique = to_orig(est.clique);
+            std::sort(clique.begin(), clique.end());
+            for (int v : clique)
+                std::cout << ' ' << v;
+            std::cout << '\n';
+        } else {
+            usage(argv[0]);
+            return 1;
         }
     } catch (const std::exception& ex) {
         std::cerr << "Error: " << ex.what() << '\n';
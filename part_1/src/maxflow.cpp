@@ -0,0 +1,214 @@
+#include "../include/maxflow.hpp"
+#include <algorithm>
+#include <queue>
+
+using namespace osproj;
+
+namespace {
+
+const double EPS = 1e-9;
+
+// Residual graph in CSR form: arcs of u are [off[u], off[u+1]); mate[a] is the reverse arc.
+struct Residual {
+    std::vector<int> off, to, mate;
+    std::vector<double> cap;
+};
+
+Residual build_residual(size_t n, const std::vector<EdgeRecord>& edges, bool directed) {
+    Residual r;
+    r.off.assign(n + 1, 0);
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        r.off[e.u + 1]++;
+        r.off[e.v + 1]++;
+    }
+    for (size_t i = 0; i < n; ++i) r.off[i + 1] += r.off[i];
+    size_t m = r.off[n];
+    r.to.resize(m);
+    r.mate.resize(m);
+    r.cap.resize(m);
+    std::vector<int> pos(r.off.begin(), r.off.end() - 1);
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        int a = pos[e.u]++, b = pos[e.v]++;
+        r.to[a] = e.v; r.cap[a] = e.w; r.mate[a] = b;
+        r.to[b] = e.u; r.cap[b] = directed ? 0 : e.w; r.mate[b] = a;
+    }
+    return r;
+}
+
+class PushRelabel {
+public:
+    PushRelabel(Residual& r, size_t n, int s, int t)
+        : _r(r), _n(static_cast<int>(n)), _s(s), _t(t),
+          _h(n, 0), _cur(n), _head(n, -1), _next(n, -1), _prev(n, -1), _ex(n, 0.0), _in_queue(n, 0) {}
+
+    double run() {
+        global_relabel();
+        _h[_s] = _n;
+        for (int a = _r.off[_s]; a < _r.off[_s + 1]; ++a) {
+            double c = _r.cap[a];
+            if (c > EPS) push(_s, a, c);
+        }
+        long long work = 0;
+        const long long relabel_every = 6LL * _n + static_cast<long long>(_r.to.size()) / 2;
+        while (!_active.empty()) {
+            int v = _active.front();
+            _active.pop();
+            _in_queue[v] = 0;
+            if (_h[v] >= _n) continue;
+            work += discharge(v);
+            if (work > relabel_every) {
+                global_relabel();
+                work = 0;
+            }
+        }
+        return _ex[_t];
+    }
+
+    // Vertices that cannot reach t in the residual graph form the s side of a minimum cut.
+    std::vector<int> source_side() const {
+        std::vector<char> reach(_n, 0);
+        std::vector<int> q{_t};
+        reach[_t] = 1;
+        for (size_t i = 0; i < q.size(); ++i) {
+            int v = q[i];
+            for (int a = _r.off[v]; a < _r.off[v + 1]; ++a) {
+                int u = _r.to[a];
+                if (!reach[u] && _r.cap[_r.mate[a]] > EPS) { reach[u] = 1; q.push_back(u); }
+            }
+        }
+        std::vector<int> side;
+        for (int v = 0; v < _n; ++v) if (!reach[v]) side.push_back(v);
+        return side;
+    }
+
+private:
+    Residual& _r;
+    int _n, _s, _t;
+    std::vector<int> _h, _cur;
+    // Vertices below height n in doubly linked lists per height, so a gap visits only the
+    // vertices it lifts. Occupied heights are always 0.._max_h without holes.
+    std::vector<int> _head, _next, _prev;
+    int _max_h = -1;
+    std::vector<double> _ex;
+    std::vector<char> _in_queue;
+    std::queue<int> _active;
+
+    void activate(int v) {
+        if (v != _s && v != _t && !_in_queue[v] && _h[v] < _n) {
+            _in_queue[v] = 1;
+            _active.push(v);
+        }
+    }
+
+    void bucket_add(int v) {
+        int h = _h[v];
+        _prev[v] = -1;
+        _next[v] = _head[h];
+        if (_head[h] >= 0) _prev[_head[h]] = v;
+        _head[h] = v;
+        _max_h = std::max(_max_h, h);
+    }
+
+    void bucket_remove(int v) {
+        if (_prev[v] >= 0) _next[_prev[v]] = _next[v];
+        else _head[_h[v]] = _next[v];
+        if (_next[v] >= 0) _prev[_next[v]] = _prev[v];
+    }
+
+    void push(int v, int a, double f) {
+        int w = _r.to[a];
+        _r.cap[a] -= f;
+        _r.cap[_r.mate[a]] += f;
+        _ex[v] -= f;
+        _ex[w] += f;
+        activate(w);
+    }
+
+    // Exact distances to t by reverse BFS in the residual graph; vertices that cannot
+    // reach t are lifted to n and drop out of the preflow phase.
+    void global_relabel() {
+        std::fill(_h.begin(), _h.end(), _n);
+        std::fill(_head.begin(), _head.end(), -1);
+        _max_h = -1;
+        _h[_t] = 0;
+        std::vector<int> q{_t};
+        for (size_t i = 0; i < q.size(); ++i) {
+            int v = q[i];
+            bucket_add(v);
+            for (int a = _r.off[v]; a < _r.off[v + 1]; ++a) {
+                int u = _r.to[a];
+                if (u != _s && _h[u] == _n && _r.cap[_r.mate[a]] > EPS) {
+                    _h[u] = _h[v] + 1;
+                    q.push_back(u);
+                }
+            }
+        }
+        _h[_s] = _n;
+        for (int v = 0; v < _n; ++v) {
+            _cur[v] = _r.off[v];
+            if (_ex[v] > EPS) activate(v);
+        }
+    }
+
+    // Gap: nobody is left at height g, so everything above it can no longer reach t.
+    void gap(int g) {
+        for (int h = g + 1; h <= _max_h; ++h) {
+            for (int v = _head[h]; v >= 0; v = _next[v]) _h[v] = _n;
+            _head[h] = -1;
+        }
+        _max_h = g - 1;
+    }
+
+    // Returns the number of arcs scanned, used to schedule global relabels.
+    long long discharge(int v) {
+        long long scanned = 0;
+        while (_ex[v] > EPS) {
+            int end = _r.off[v + 1];
+            int& a = _cur[v];
+            for (; a < end && _ex[v] > EPS; ++a) {
+                ++scanned;
+                int w = _r.to[a];
+                if (_r.cap[a] > EPS && _h[v] == _h[w] + 1)
+                    push(v, a, std::min(_ex[v], _r.cap[a]));
+                if (_ex[v] <= EPS) break;
+            }
+            if (_ex[v] <= EPS) break;
+
+            // relabel
+            int old = _h[v], nh = 2 * _n;
+            for (int b = _r.off[v]; b < end; ++b) {
+                ++scanned;
+                if (_r.cap[b] > EPS) nh = std::min(nh, _h[_r.to[b]] + 1);
+            }
+            bucket_remove(v);
+            if (_head[old] < 0) {
+                gap(old);
+                _h[v] = _n;
+            } else {
+                _h[v] = std::min(nh, _n);
+            }
+            if (_h[v] >= _n) break;
+            bucket_add(v);
+            _cur[v] = _r.off[v];
+        }
+        return scanned;
+    }
+};
+
+} // namespace
+
+MaxFlowResult osproj::max_flow(size_t n, const std::vector<EdgeRecord>& edges, bool directed, int s, int t) {
+    if (s < 0 || t < 0 || static_cast<size_t>(s) >= n || static_cast<size_t>(t) >= n)
+        throw std::out_of_range("Invalid source or sink vertex");
+    if (s == t)
+        throw std::invalid_argument("Source and sink must differ");
+
+    Residual r = build_residual(n, edges, directed);
+    PushRelabel pr(r, n, s, t);
+    MaxFlowResult res;
+    res.value = pr.run();
+    res.source_side = pr.source_side();
+    return res;
+}
@@ -0,0 +1,179 @@
+#include "../include/mst.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <numeric>
+
+using namespace osproj;
+
+namespace {
+
+unsigned thread_count(unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+
+size_t slice_size(size_t n, unsigned threads) {
+    return std::max<size_t>(1, (n + threads - 1) / threads);
+}
+
+// Splits [0, n) into `threads` contiguous slices of slice_size() items and runs
+// f(slice, begin, end) for each, one thread per slice; waits for all of them.
+template <typename F>
+void parallel_slices(size_t n, unsigned threads, F f) {
+    size_t chunk = slice_size(n, threads);
+    bool spawn = threads > 1 && n >= threads;
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t lo = std::min(n, t * chunk), hi = std::min(n, lo + chunk);
+        if (spawn) pool.emplace_back(f, t, lo, hi);
+        else f(t, lo, hi);
+    }
+    for (auto& th : pool) th.join();
+}
+
+// Strict total order on edges: weight, then id.
+struct EdgeLess {
+    const std::vector<EdgeRecord>& e;
+    bool operator()(int a, int b) const {
+        return e[a].w < e[b].w || (e[a].w == e[b].w && a < b);
+    }
+};
+
+MstResult finish(const std::vector<EdgeRecord>& edges, std::vector<int> picked) {
+    MstResult r;
+    std::sort(picked.begin(), picked.end());
+    for (int id : picked) r.weight += edges[id].w;
+    r.edges = std::move(picked);
+    return r;
+}
+
+} // namespace
+
+MstResult osproj::mst_kruskal(size_t n, const std::vector<EdgeRecord>& edges, unsigned threads) {
+    threads = thread_count(threads);
+    std::vector<int> order(edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    EdgeLess less{edges};
+
+    // Sort equal slices in parallel, then merge neighbouring runs level by level.
+    size_t m = order.size();
+    parallel_slices(m, threads, [&](unsigned, size_t lo, size_t hi) {
+        std::sort(order.begin() + lo, order.begin() + hi, less);
+    });
+    for (size_t run = slice_size(m, threads); run < m; run *= 2) {
+        size_t pairs = (m + 2 * run - 1) / (2 * run);
+        parallel_slices(pairs, threads, [&](unsigned, size_t lo, size_t hi) {
+            for (size_t p = lo; p < hi; ++p) {
+                size_t b = p * 2 * run;
+                size_t mid = std::min(m, b + run), end = std::min(m, b + 2 * run);
+                std::inplace_merge(order.begin() + b, order.begin() + mid, order.begin() + end, less);
+            }
+        });
+    }
+
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    };
+    std::vector<int> picked;
+    for (int id : order) {
+        int a = find(edges[id].u), b = find(edges[id].v);
+        if (a == b) continue;
+        parent[a] = b;
+        picked.push_back(id);
+        if (picked.size() + 1 == n) break;
+    }
+    return finish(edges, std::move(picked));
+}
+
+MstResult osproj::mst_boruvka(size_t n, const std::vector<EdgeRecord>& edges, unsigned threads) {
+    threads = thread_count(threads);
+    const int NONE = -1;
+    EdgeLess less{edges};
+
+    std::vector<std::atomic<int>> parent(n), best(n);
+    parallel_slices(n, threads, [&](unsigned, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) parent[i].store(static_cast<int>(i), std::memory_order_relaxed);
+    });
+
+    // Lock-free find with path halving: a lost CAS only means someone else shortened the path.
+    auto find = [&](int x) {
+        while (true) {
+            int p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            int gp = parent[p].load(std::memory_order_relaxed);
+            if (gp != p) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            x = gp;
+        }
+    };
+    // Keep the lighter of the current candidate and `id` for component r.
+    auto offer = [&](int r, int id) {
+        int cur = best[r].load(std::memory_order_relaxed);
+        while ((cur == NONE || less(id, cur)) &&
+               !best[r].compare_exchange_weak(cur, id, std::memory_order_relaxed)) {}
+    };
+
+    // Live edges: not self-loops and not yet inside one component. Each slice compacts itself.
+    std::vector<int> live;
+    live.reserve(edges.size());
+    for (const auto& e : edges) if (e.u != e.v) live.push_back(e.id);
+
+    std::vector<std::vector<int>> picked(threads);
+    while (!live.empty()) {
+        parallel_slices(n, threads, [&](unsigned, size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) best[i].store(NONE, std::memory_order_relaxed);
+        });
+
+        std::vector<size_t> kept(threads, 0);
+        parallel_slices(live.size(), threads, [&](unsigned t, size_t lo, size_t hi) {
+            size_t out = lo;
+            for (size_t i = lo; i < hi; ++i) {
+                int id = live[i];
+                int a = find(edges[id].u), c = find(edges[id].v);
+                if (a == c) continue;
+                live[out++] = id;
+                offer(a, id);
+                offer(c, id);
+            }
+            kept[t] = out - lo;
+        });
+
+        // Hook: ties are broken by id, so the chosen edges form a forest and each distinct
+        // edge merges two components; an edge chosen from both sides is only counted once.
+        // Roots are always linked towards the smaller index, which keeps the forest acyclic.
+        std::atomic<bool> merged{false};
+        parallel_slices(n, threads, [&](unsigned t, size_t lo, size_t hi) {
+            for (size_t r = lo; r < hi; ++r) {
+                int id = best[r].load(std::memory_order_relaxed);
+                if (id == NONE) continue;
+                while (true) {
+                    int a = find(edges[id].u), c = find(edges[id].v);
+                    if (a == c) break;
+                    if (a < c) std::swap(a, c);
+                    if (parent[a].compare_exchange_strong(a, c, std::memory_order_relaxed)) {
+                        picked[t].push_back(id);
+                        merged.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+            }
+        });
+        if (!merged.load()) break;
+
+        // Gather the compacted slices back into one contiguous list.
+        size_t chunk = slice_size(live.size(), threads), total = 0;
+        for (unsigned t = 0; t < threads; ++t) {
+            size_t b = std::min(live.size(), t * chunk);
+            if (b != total) std::copy(live.begin() + b, live.begin() + b + kept[t], live.begin() + total);
+            total += kept[t];
+        }
+        live.resize(total);
+    }
+
+    std::vector<int> all;
+    for (auto& p : picked) all.insert(all.end(), p.begin(), p.end());
+    return finish(edges, std::move(all));
+}
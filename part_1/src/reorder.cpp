@@ -0,0 +1,97 @@
+#include "../include/reorder.hpp"
+#include "../include/triangles.hpp"
+#include <algorithm>
+#include <numeric>
+
+using namespace osproj;
+
+std::vector<int> Reordered::to_old(const std::vector<int>& vs) const {
+    std::vector<int> out;
+    out.reserve(vs.size());
+    for (int v : vs) out.push_back(to_old(v));
+    return out;
+}
+
+namespace {
+
+// BFS over every component. Roots are the lowest-degree unvisited vertex (a cheap
+// pseudo-peripheral choice); with by_degree, neighbours are queued in ascending degree.
+std::vector<int> bfs_order(const SortedAdjacency& a, bool by_degree) {
+    size_t n = a.vertex_count();
+    std::vector<int> roots(n), order;
+    std::iota(roots.begin(), roots.end(), 0);
+    std::stable_sort(roots.begin(), roots.end(), [&](int x, int y) { return a.degree(x) < a.degree(y); });
+    std::vector<char> seen(n, 0);
+    std::vector<int> level;
+    order.reserve(n);
+    for (int r : roots) {
+        if (seen[r]) continue;
+        seen[r] = 1;
+        order.push_back(r);
+        for (size_t h = order.size() - 1; h < order.size(); ++h) {
+            int u = order[h];
+            level.clear();
+            for (size_t i = 0; i < a.degree(u); ++i) {
+                int w = a.begin(u)[i];
+                if (!seen[w]) { seen[w] = 1; level.push_back(w); }
+            }
+            if (by_degree)
+                std::stable_sort(level.begin(), level.end(), [&](int x, int y) { return a.degree(x) < a.degree(y); });
+            order.insert(order.end(), level.begin(), level.end());
+        }
+    }
+    return order;
+}
+
+} // namespace
+
+std::vector<int> osproj::compute_ordering(const Graph& g, Ordering o) {
+    SortedAdjacency a = sorted_adjacency(g);
+    switch (o) {
+    case Ordering::RCM: {
+        std::vector<int> order = bfs_order(a, true);
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+    case Ordering::BFS:
+        return bfs_order(a, false);
+    case Ordering::DEGREE: {
+        std::vector<int> order(a.vertex_count());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return a.degree(x) > a.degree(y); });
+        return order;
+    }
+    }
+    throw std::invalid_argument("Unknown ordering");
+}
+
+Reordered osproj::relabel(const Graph& g, std::vector<int> old_id) {
+    size_t n = g.vertex_count();
+    if (old_id.size() != n)
+        throw std::invalid_argument("Permutation size does not match vertex count");
+    Reordered r{Graph(n, g.type()), std::move(old_id), std::vector<int>(n, -1), {}};
+    for (size_t i = 0; i < n; ++i) {
+        int v = r.old_id[i];
+        if (v < 0 || static_cast<size_t>(v) >= n || r.new_id[v] != -1)
+            throw std::invalid_argument("Not a permutation of the vertices");
+        r.new_id[v] = static_cast<int>(i);
+    }
+
+    // Counting sort of the edges by new source, then by new target inside each bucket.
+    const auto& edges = g.edges();
+    std::vector<int> start(n + 1, 0);
+    for (const auto& e : edges) start[r.new_id[e.u] + 1]++;
+    for (size_t i = 0; i < n; ++i) start[i + 1] += start[i];
+    r.old_edge.resize(edges.size());
+    std::vector<int> pos(start.begin(), start.end() - 1);
+    for (const auto& e : edges) r.old_edge[pos[r.new_id[e.u]]++] = e.id;
+    for (size_t u = 0; u < n; ++u) {
+        std::stable_sort(r.old_edge.begin() + start[u], r.old_edge.begin() + start[u + 1],
+                         [&](int x, int y) { return r.new_id[edges[x].v] < r.new_id[edges[y].v]; });
+    }
+    for (int id : r.old_edge) {
+        const EdgeRecord& e = edges[id];
+        r.graph.add_edge(r.new_id[e.u], r.new_id[e.v], e.w);
+    }
+    return r;
+}
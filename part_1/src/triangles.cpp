@@ -0,0 +1,172 @@
+#include "../include/triangles.hpp"
+#include <algorithm>
+#include <numeric>
+
+using namespace osproj;
+
+namespace {
+
+// Forward lists at or above this length are probed through a bitset.
+const size_t BITSET_MIN_DEGREE = 128;
+
+// Relabels vertices by (degree, id) and keeps each edge only from the lower to the
+// higher rank; lists are sorted by rank so they can be intersected directly.
+SortedAdjacency orient_by_degree(const SortedAdjacency& a) {
+    size_t n = a.vertex_count();
+    std::vector<int> order(n), rank(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int x, int y) {
+        return a.degree(x) < a.degree(y) || (a.degree(x) == a.degree(y) && x < y);
+    });
+    for (size_t r = 0; r < n; ++r) rank[order[r]] = static_cast<int>(r);
+
+    SortedAdjacency f;
+    f.off.assign(n + 1, 0);
+    f.adj.reserve(a.adj.size() / 2);
+    for (size_t r = 0; r < n; ++r) {
+        int u = order[r];
+        size_t start = f.adj.size();
+        for (size_t i = 0; i < a.degree(u); ++i) {
+            int w = rank[a.begin(u)[i]];
+            if (w > static_cast<int>(r)) f.adj.push_back(w);
+        }
+        std::sort(f.adj.begin() + start, f.adj.end());
+        f.off[r + 1] = static_cast<int>(f.adj.size());
+    }
+    return f;
+}
+
+} // namespace
+
+SortedAdjacency osproj::sorted_adjacency(const Graph& g) {
+    size_t n = g.vertex_count();
+    SortedAdjacency a;
+    a.off.assign(n + 1, 0);
+    for (const auto& e : g.edges()) {
+        if (e.u == e.v) continue;
+        a.off[e.u + 1]++;
+        a.off[e.v + 1]++;
+    }
+    for (size_t i = 0; i < n; ++i) a.off[i + 1] += a.off[i];
+    a.adj.resize(a.off[n]);
+    std::vector<int> pos(a.off.begin(), a.off.end() - 1);
+    for (const auto& e : g.edges()) {
+        if (e.u == e.v) continue;
+        a.adj[pos[e.u]++] = e.v;
+        a.adj[pos[e.v]++] = e.u;
+    }
+
+    // sort + dedup each list, compacting in place
+    int out = 0;
+    for (size_t u = 0; u < n; ++u) {
+        auto b = a.adj.begin() + a.off[u], e = a.adj.begin() + a.off[u + 1];
+        std::sort(b, e);
+        auto last = std::unique(b, e);
+        a.off[u] = out;
+        out = static_cast<int>(std::copy(b, last, a.adj.begin() + out) - a.adj.begin());
+    }
+    a.off[n] = out;
+    a.adj.resize(out);
+    a.adj.shrink_to_fit();
+    return a;
+}
+
+uint64_t osproj::count_triangles(const Graph& g, IntersectKernel k) {
+    return count_triangles(sorted_adjacency(g), k);
+}
+
+uint64_t osproj::count_triangles(const SortedAdjacency& a, IntersectKernel k) {
+    SortedAdjacency f = orient_by_degree(a);
+    size_t n = f.vertex_count();
+    std::vector<uint64_t> bits((n + 63) / 64, 0);
+    uint64_t total = 0;
+
+    for (size_t u = 0; u < n; ++u) {
+        const int* nu = f.begin(static_cast<int>(u));
+        size_t du = f.degree(static_cast<int>(u));
+        if (k == IntersectKernel::AUTO && du >= BITSET_MIN_DEGREE) {
+            for (size_t i = 0; i < du; ++i) bits[nu[i] >> 6] |= uint64_t{1} << (nu[i] & 63);
+            for (size_t i = 0; i < du; ++i) {
+                const int* nv = f.begin(nu[i]);
+                size_t dv = f.degree(nu[i]);
+                for (size_t j = 0; j < dv; ++j) total += (bits[nv[j] >> 6] >> (nv[j] & 63)) & 1;
+            }
+            for (size_t i = 0; i < du; ++i) bits[nu[i] >> 6] = 0;
+            continue;
+        }
+        for (size_t i = 0; i < du; ++i)
+            total += intersect_count(nu, du, f.begin(nu[i]), f.degree(nu[i]), k);
+    }
+    return total;
+}
+
+CliqueEstimate osproj::max_clique_estimate(const Graph& g) {
+    SortedAdjacency a = sorted_adjacency(g);
+    size_t n = a.vertex_count();
+    CliqueEstimate est;
+    if (n == 0) return est;
+
+    // Bucket peeling: core numbers and a degeneracy order.
+    size_t maxd = 0;
+    std::vector<int> deg(n), core(n), order, pos(n);
+    for (size_t u = 0; u < n; ++u) {
+        deg[u] = static_cast<int>(a.degree(static_cast<int>(u)));
+        maxd = std::max(maxd, static_cast<size_t>(deg[u]));
+    }
+    std::vector<std::vector<int>> bucket(maxd + 1);
+    for (size_t u = 0; u < n; ++u) bucket[deg[u]].push_back(static_cast<int>(u));
+    std::vector<char> done(n, 0);
+    int k = 0;
+    for (size_t d = 0; d <= maxd;) {
+        if (bucket[d].empty()) { ++d; continue; }
+        int u = bucket[d].back();
+        bucket[d].pop_back();
+        if (done[u] || deg[u] != static_cast<int>(d)) continue; // stale entry
+        done[u] = 1;
+        k = std::max(k, static_cast<int>(d));
+        core[u] = k;
+        pos[u] = static_cast<int>(order.size());
+        order.push_back(u);
+        for (size_t i = 0; i < a.degree(u); ++i) {
+            int w = a.begin(u)[i];
+            if (!done[w] && deg[w] > 0) bucket[--deg[w]].push_back(w);
+        }
+        if (d > 0) --d; // a neighbour may have dropped into the previous bucket
+    }
+    est.upper_bound = k + 1;
+
+    std::vector<int> by_core(order.rbegin(), order.rend());
+    std::stable_sort(by_core.begin(), by_core.end(), [&](int x, int y) { return core[x] > core[y]; });
+    std::vector<int> cand, next, clique;
+    est.clique = {by_core.front()};
+
+    for (int u : by_core) {
+        size_t best = est.clique.size();
+        if (static_cast<size_t>(core[u]) + 1 <= best) break;
+        // Every clique has a first member in degeneracy order and lies in its forward set.
+        cand.clear();
+        for (size_t i = 0; i < a.degree(u); ++i) {
+            int w = a.begin(u)[i];
+            if (pos[w] > pos[u] && static_cast<size_t>(core[w]) >= best) cand.push_back(w);
+        }
+        if (cand.size() + 1 <= best) continue;
+
+        clique.assign(1, u);
+        while (!cand.empty()) {
+            int pick = cand[0];
+            size_t pick_deg = 0;
+            for (int v : cand) {
+                size_t c = intersect_count(cand.data(), cand.size(), a.begin(v), a.degree(v));
+                if (c > pick_deg) { pick = v; pick_deg = c; }
+            }
+            clique.push_back(pick);
+            next.resize(std::min(cand.size(), a.degree(pick)));
+            next.resize(intersect_into(cand.data(), cand.size(), a.begin(pick), a.degree(pick), next.data()));
+            cand.swap(next);
+            if (clique.size() + cand.size() <= best) break;
+        }
+        if (clique.size() > best) est.clique = clique;
+    }
+    std::sort(est.clique.begin(), est.clique.end());
+    return est;
+}
@@ -0,0 +1,110 @@
+// Cost of one trace::Scope in-process, then request throughput against a live server
+// with tracing off, sampled at 1% and at 100%.
+// Build: make bench  (starts a server on $(BENCH_PORT), runs this, stops it)
+// Run:   ../bin/part3_trace_bench [host] [port] [clients] [requests per client]
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "trace.hpp"
+
+static FILE* connect_to(const char* host, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return nullptr;
+    sockaddr_in addr{}; addr.sin_family = AF_INET; addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1 || connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    FILE* fp = fdopen(fd, "r+");
+    if (!fp) close(fd);
+    return fp;
+}
+
+// One request, one reply line; the server handles a connection strictly in turn.
+static std::string call(FILE* fp, const std::string& cmd) {
+    static thread_local char* buf = nullptr;
+    static thread_local size_t cap = 0;
+    fprintf(fp, "%s\n", cmd.c_str());
+    fflush(fp);
+    if (getline(&buf, &cap, fp) == -1) return "";
+    return buf;
+}
+
+// Nanoseconds per Scope with the current thread sampled or not.
+static double scope_ns(bool sampled) {
+    const int iters = 2'000'000;
+    trace::setSampled(sampled);
+    uint64_t t0 = trace::nowNs();
+    for (int i = 0; i < iters; ++i) { trace::Scope s("probe", i); }
+    uint64_t t1 = trace::nowNs();
+    trace::setSampled(false);
+    return double(t1 - t0) / iters;
+}
+
+int main(int argc, char** argv) {
+    const char* host = argc > 1 ? argv[1] : "127.0.0.1";
+    int port = argc > 2 ? std::stoi(argv[2]) : 5000;
+    int clients = argc > 3 ? std::stoi(argv[3]) : 4;
+    int requests = argc > 4 ? std::stoi(argv[4]) : 5000;
+
+    // A connection holds a server worker until QUIT, so control commands use their own
+    // short-lived connection and never compete with the load clients.
+    std::printf("trace::Scope: %.1f ns unsampled, %.1f ns sampled\n", scope_ns(false), scope_ns(true));
+
+    FILE* ctl = connect_to(host, port);
+    if (!ctl) { perror("connect"); return 1; }
+
+    // 20x20 grid on its own graph: BFS does some work, and the reply (~1.6 KB) still goes
+    // out in one write, so TCP delayed ACKs do not dominate the timing.
+    const int side = 20;
+    call(ctl, "DROP trace_bench");
+    call(ctl, "CREATE trace_bench");
+    call(ctl, "USE trace_bench");
+    for (int i = 0; i < side * side; ++i) call(ctl, "ADD_NODE " + std::to_string(i));
+    for (int r = 0; r < side; ++r)
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side) { call(ctl, "ADD_EDGE " + std::to_string(v) + " " + std::to_string(v + 1));
+                                call(ctl, "ADD_EDGE " + std::to_string(v + 1) + " " + std::to_string(v)); }
+            if (r + 1 < side) { call(ctl, "ADD_EDGE " + std::to_string(v) + " " + std::to_string(v + side));
+                                call(ctl, "ADD_EDGE " + std::to_string(v + side) + " " + std::to_string(v)); }
+        }
+    call(ctl, "QUIT");
+    fclose(ctl);
+
+    struct Mode { const char* label; const char* cmd; };
+    const Mode modes[] = {{"off", "TRACE OFF"}, {"1%", "TRACE ON 0.01"}, {"100%", "TRACE ON 1"}, {"off", "TRACE OFF"}};
+    std::printf("%d clients x %d BFS requests, %dx%d grid\n", clients, requests, side, side);
+    std::printf("%-8s %12s %12s\n", "tracing", "req/s", "us/req");
+    for (const Mode& m : modes) {
+        if ((ctl = connect_to(host, port))) { call(ctl, m.cmd); call(ctl, "QUIT"); fclose(ctl); }
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> ts;
+        for (int c = 0; c < clients; ++c)
+            ts.emplace_back([&, c] {
+                FILE* fp = connect_to(host, port);
+                if (!fp) return;
+                call(fp, "USE trace_bench");
+                for (int i = 0; i < requests; ++i) call(fp, "BFS " + std::to_string((c * 97 + i) % (side * side)));
+                call(fp, "QUIT");
+                fclose(fp);
+            });
+        for (auto& t : ts) t.join();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        double total = double(clients) * requests;
+        std::printf("%-8s %12.0f %12.1f\n", m.label, total / s, s * 1e6 / total * clients);
+    }
+    if ((ctl = connect_to(host, port))) {
+        call(ctl, "TRACE OFF");
+        call(ctl, "DROP trace_bench");
+        call(ctl, "QUIT");
+        fclose(ctl);
+    }
+    return 0;
+}
@@ -26,13 +26,14 @@ int main(int argc, char** argv) {
     if (!fp) { close(fd); return 1; }
 
     std::string line;
+    char* resp = nullptr; size_t cap = 0; // responses such as SCC IDS can be long
     while (std::getline(std::cin, line)) {
         fprintf(fp, "%s\n", line.c_str());
         fflush(fp);
-        char buf[8192];
-        if (!fgets(buf, sizeof(buf), fp)) break;
-        std::cout << buf;
+        if (getline(&resp, &cap, fp) == -1) break;
+        std::cout << resp;
     }
+    free(resp);
     fclose(fp);
     return 0;
 }
@@ -0,0 +1,80 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <memory>
+#include "graph.hpp"
+
+// ALT index (A*, Landmarks, Triangle inequality) for weighted point-to-point queries.
+// Every method expects the caller to hold the graph lock. buildAsync() takes a
+// snapshot under that lock and runs the landmark Dijkstras on a background thread,
+// which re-acquires the lock only to install the finished tables.
+// Edge weights must be non-negative (the server rejects negative ADD_EDGE weights).
+class AltIndex {
+public:
+    enum class Strategy { FARTHEST, DEGREE };
+
+    // Tables take 16 bytes per node per landmark; more than this buys nothing.
+    static constexpr size_t MAX_LANDMARKS = 64;
+
+    struct Stats {
+        std::string state;          // none | building | ready | ready+building | failed
+        std::vector<int> landmarks; // node ids
+        double prepMs = 0;          // wall time of the last completed build
+        size_t bytes = 0;           // memory held by the landmark tables
+        size_t repairs = 0;         // incremental repairs since the last build
+        std::string error;          // why the last build failed (state == failed)
+    };
+
+    // Starts a background rebuild with k (1..MAX_LANDMARKS) landmarks. Returns false if one
+    // is already running. A build that throws (e.g. bad_alloc) leaves state "failed".
+    // keepAlive is held by the background thread so the owner of g, gm and this index
+    // cannot be destroyed under it.
+    bool buildAsync(const Graph& g, std::mutex& gm, size_t k, Strategy s,
+                    std::shared_ptr<void> keepAlive = nullptr);
+
+    // Forgets all tables (the graph was replaced); a build in flight is discarded.
+    void reset();
+
+    // Must be called after every successful addEdge so the tables stay exact.
+    void onEdgeAdded(const Graph& g, int u, int v, int w);
+
+    // Weighted shortest path length src->dst (nullopt if missing node or unreachable).
+    // Uses landmark lower bounds when the tables are ready, plain Dijkstra with early exit otherwise.
+    std::optional<long long> shortestPath(const Graph& g, int src, int dst) const;
+
+    Stats stats() const;
+
+private:
+    using Adj = std::vector<std::vector<std::pair<int,int>>>; // dense: idx -> (idx, w)
+
+    struct PendingEdge { int u, v, w; };
+
+    struct Tables {
+        std::unordered_map<int, int> idx; // node id -> dense index
+        std::vector<int> ids;             // dense index -> node id
+        Adj radj;                         // reverse adjacency, kept for repairs
+        std::vector<int> landmarks;       // node ids
+        std::vector<long long> from, to;  // [x * k + i]: d(L_i, x) and d(x, L_i)
+        size_t k = 0;
+        double prepMs = 0;
+    };
+
+    static void compute(Tables& t, const Adj& fwd, size_t k, Strategy s);
+    static size_t ensure(Tables& t, int id);
+    static void repair(Tables& t, const Graph& g, int u, int v, int w);
+    static size_t bytesOf(const Tables& t);
+
+    long long heuristic(size_t x, size_t dst) const;
+
+    Tables cur_;
+    bool ready_ = false;
+    bool building_ = false;
+    size_t repairs_ = 0;
+    unsigned generation_ = 0; // bumped by reset() so stale builds are not installed
+    std::vector<PendingEdge> pending_; // edges added while building
+    std::string error_;                // last build failure, cleared by the next success
+};
@@ -27,7 +27,17 @@ public:
     // Unweighted shortest path length (in hops)
     std::optional<int> shortestPathUnweighted(int src, int dst) const;
 
+    size_t nodeCount() const { return adj.size(); }
+    size_t edgeCount() const { return numEdges; } // directed arcs
+
+    // Approximate heap footprint of the adjacency structure
+    size_t memoryBytes() const;
+
+    // Read-only view of the adjacency list (used by the algorithm engines)
+    const std::unordered_map<int, std::vector<std::pair<int,int>>>& adjacency() const { return adj; }
+
 private:
     // adjacency list: u -> vector of (v, w)
     std::unordered_map<int, std::vector<std::pair<int,int>>> adj;
+    size_t numEdges = 0;
 };
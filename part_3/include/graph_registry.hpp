@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "graph.hpp"
+#include "alt.hpp"
+
+// One named graph with its own lock, so tenants on different graphs never wait on each other.
+struct GraphEntry {
+    explicit GraphEntry(std::string n) : name(std::move(n)) {}
+
+    const std::string name;
+    std::mutex mtx;                  // guards g and alt
+    Graph g;
+    AltIndex alt;
+    std::atomic<bool> dropped{false};
+
+    // Graph plus ALT tables; caller holds mtx.
+    size_t memoryBytes() const { return g.memoryBytes() + alt.stats().bytes; }
+};
+
+// Name -> graph map. Sessions keep a shared_ptr to the graph they USE, so DROP only
+// unlinks the name and frees the contents; late users see `dropped`.
+class GraphRegistry {
+public:
+    // Names are 1-64 characters of [A-Za-z0-9_-].
+    static bool validName(const std::string& name);
+
+    // nullptr if the name is invalid or already taken.
+    std::shared_ptr<GraphEntry> create(const std::string& name);
+    std::shared_ptr<GraphEntry> getOrCreate(const std::string& name);
+    std::shared_ptr<GraphEntry> get(const std::string& name) const;
+    bool drop(const std::string& name);
+    std::vector<std::shared_ptr<GraphEntry>> list() const;
+
+private:
+    mutable std::mutex m_;
+    std::map<std::string, std::shared_ptr<GraphEntry>> graphs_;
+};
+
+// Largest node count LOAD accepts; the header is untrusted input.
+constexpr long long LOAD_MAX_NODES = 10'000'000;
+
+// Reads a part_1 graph file: "U|D <n> <m>" then m lines "u v [w]". Creates nodes 0..n-1;
+// undirected edges are added in both directions and weights (0..INT_MAX) are rounded to int.
+// Only regular files are read.
+// On success edges is m (edges as listed in the file, not directed arcs).
+// Returns nullopt and sets err on failure.
+std::optional<Graph> loadGraphFile(const std::string& path, size_t& edges, std::string& err);
@@ -0,0 +1,18 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <utility>
+#include "graph.hpp"
+#include "thread_pool.hpp"
+
+struct SccResult {
+    int count = 0;                       // number of strongly connected components
+    int largest = 0;                     // size of the largest one
+    std::vector<std::pair<int,int>> ids; // (node id, component id), sorted; only when requested
+};
+
+// Strongly connected components of g. The adjacency is copied to CSR under gm, then
+// the lock is released. Large graphs use parallel forward-backward decomposition with
+// trimming on pool; small graphs and small sub-problems use an iterative Tarjan.
+// pool must not be the pool the caller runs on (the caller blocks until done).
+SccResult strongComponents(const Graph& g, std::mutex& gm, ThreadPool& pool, bool withIds);
@@ -3,17 +3,22 @@
 #include <thread>
 #include <functional>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <string>
 #include "ts_queue.hpp"
+#include "trace.hpp"
 
 class ThreadPool {
 public:
-    explicit ThreadPool(size_t n = std::thread::hardware_concurrency())
+    explicit ThreadPool(size_t n = std::thread::hardware_concurrency(), const char* name = "worker")
       : stop_(false)
     {
         if (n == 0) n = 2;
         workers_.reserve(n);
         for (size_t i = 0; i < n; ++i) {
-            workers_.emplace_back([this] {
+            workers_.emplace_back([this, name, i] {
+                trace::setThreadName(std::string(name) + "-" + std::to_string(i));
                 while (!stop_) {
                     auto job = jobs_.pop();
                     if (!job) break;      // queue stopped and empty
@@ -25,7 +30,20 @@ public:
 
     ~ThreadPool() { shutdown(); }
 
-    void submit(std::function<void()> fn) { jobs_.push(std::move(fn)); }
+    // A job submitted from a sampled request stays sampled on the worker and records
+    // how long it waited in the queue and how long it ran.
+    void submit(std::function<void()> fn) {
+        if (!trace::sampled()) { jobs_.push(std::move(fn)); return; }
+        uint64_t t0 = trace::nowNs();
+        jobs_.push([fn = std::move(fn), t0] {
+            uint64_t start = trace::nowNs();
+            trace::record("queue_wait", t0, start - t0);
+            trace::setSampled(true);
+            fn();
+            trace::record("job", start, trace::nowNs() - start);
+            trace::setSampled(false);
+        });
+    }
 
     void shutdown() {
         if (stop_.exchange(true)) return;
@@ -38,3 +56,28 @@ private:
     std::vector<std::thread> workers_;
     std::atomic<bool> stop_;
 };
+
+// Counts outstanding jobs so a caller can block until a batch of jobs
+// (including jobs they submit themselves) has finished.
+class WaitGroup {
+public:
+    void add(size_t n = 1) {
+        std::lock_guard<std::mutex> lk(m_);
+        count_ += n;
+    }
+
+    void done() {
+        std::lock_guard<std::mutex> lk(m_);
+        if (--count_ == 0) cv_.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk, [&]{ return count_ == 0; });
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable cv_;
+    size_t count_ = 0;
+};
@@ -5,31 +5,65 @@
 #include <sstream>
 #include <mutex>
 #include <vector>
+#include <memory>
+#include <optional>
+#include <cstdlib>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include "graph.hpp"
+#include "alt.hpp"
+#include "graph_registry.hpp"
+#include "scc.hpp"
 #include "thread_pool.hpp"
+#include "trace.hpp"
 
-static Graph G;
-static std::mutex G_MTX;
+static GraphRegistry REGISTRY;
+static std::string TRACE_DIR = "/tmp"; // TRACE DUMP only writes <name>.json in here
+static std::string LOAD_DIR = ".";     // LOAD only reads <file>.txt from here
+static ThreadPool ALGO_POOL(std::thread::hardware_concurrency(), "algo"); // separate from the connection pool
 
 static void trim_newlines(std::string& s) {
     while (!s.empty() && (s.back()=='\n' || s.back()=='\r')) s.pop_back();
 }
 
+// Acquires the graph's lock, recording the wait when the request is traced.
+static std::unique_lock<std::mutex> lock_graph(GraphEntry& e) {
+    trace::Scope s("graph lock wait");
+    return std::unique_lock<std::mutex>(e.mtx);
+}
+
+// fflush is where the reply actually hits the socket.
+static void flush_reply(FILE* fp) {
+    trace::Scope s("write");
+    fflush(fp);
+}
+
+// Trace event names must outlive the ring buffers, so map ops to literals.
+static const char* op_name(const std::string& op) {
+    static const char* const NAMES[] = {"ADD_NODE", "ADD_EDGE", "BFS", "SHORTEST_PATH", "ALT_BUILD",
+                                        "ALT_STATS", "SCC", "TRACE", "USE", "CREATE", "DROP",
+                                        "LOAD", "GRAPHS"};
+    for (const char* n : NAMES) if (op == n) return n;
+    return "UNKNOWN";
+}
+
 static void print_unknown(FILE* fp) {
     fprintf(fp,
         "ERR unknown cmd\n"
-        "Use: ADD_NODE <id> | ADD_EDGE <u> <v> [w] | BFS <src> | SHORTEST_PATH <src> <dst> | QUIT | HELP\n"
+        "Use: ADD_NODE <id> | ADD_EDGE <u> <v> [w] | BFS <src> | SHORTEST_PATH <src> <dst> [W] | "
+        "ALT_BUILD [k] [farthest|degree] | ALT_STATS | SCC [IDS] | "
+        "USE <name> | CREATE <name> | DROP <name> | LOAD <name> <file> | GRAPHS | "
+        "TRACE ON [rate] | TRACE OFF | TRACE DUMP <name> | QUIT | HELP\n"
     );
-    fflush(fp);
+    flush_reply(fp);
 }
 
 static void handle_client(int client_fd) {
     FILE* fp = fdopen(client_fd, "r+");
     if (!fp) { close(client_fd); return; }
     char* line = nullptr; size_t n = 0;
+    std::shared_ptr<GraphEntry> cur = REGISTRY.get("default"); // graph selected by USE
 
     while (true) {
         ssize_t r = getline(&line, &n, fp);
@@ -37,39 +71,190 @@ static void handle_client(int client_fd) {
 
         std::string cmd(line);
         trim_newlines(cmd);
-        if (cmd.empty()) { fprintf(fp, "ERR empty\n"); fflush(fp); continue; }
-        if (cmd == "QUIT") { fprintf(fp, "OK Bye\n"); fflush(fp); break; }
+        trace::setSampled(false); // the early replies below are not traced requests
+        if (cmd.empty()) { fprintf(fp, "ERR empty\n"); flush_reply(fp); continue; }
+        if (cmd == "QUIT") { fprintf(fp, "OK Bye\n"); flush_reply(fp); break; }
         if (cmd == "HELP") { print_unknown(fp); continue; }
 
         std::istringstream iss(cmd);
         std::string op; iss >> op;
+        trace::sample();
+        trace::Scope req(op_name(op));
+
+        static const char* const GRAPH_OPS[] = {"ADD_NODE", "ADD_EDGE", "BFS", "SHORTEST_PATH",
+                                                "ALT_BUILD", "ALT_STATS", "SCC"};
+        bool needsGraph = false;
+        for (const char* g : GRAPH_OPS) if (op == g) needsGraph = true;
+        if (needsGraph && (!cur || cur->dropped)) {
+            fprintf(fp, cur ? "ERR graph dropped\n" : "ERR no graph selected\n");
+            flush_reply(fp); continue;
+        }
+        // A DROP racing past the check above only leaves this request an empty graph.
 
         if (op == "ADD_NODE") {
-            int id; if (!(iss >> id)) { fprintf(fp, "ERR bad args\n"); fflush(fp); continue; }
-            { std::lock_guard<std::mutex> lk(G_MTX); G.addNode(id); }
-            fprintf(fp, "OK\n"); fflush(fp);
+            int id; if (!(iss >> id)) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
+            { auto lk = lock_graph(*cur); cur->g.addNode(id); }
+            fprintf(fp, "OK\n"); flush_reply(fp);
 
         } else if (op == "ADD_EDGE") {
-            int u,v,w=1; if (!(iss >> u >> v)) { fprintf(fp, "ERR bad args\n"); fflush(fp); continue; }
+            int u,v,w=1; if (!(iss >> u >> v)) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
             if (!(iss >> w)) w = 1;
+            // Dijkstra and the ALT bounds assume non-negative weights.
+            if (w < 0) { fprintf(fp, "ERR negative weight\n"); flush_reply(fp); continue; }
             bool ok;
-            { std::lock_guard<std::mutex> lk(G_MTX); ok = G.addEdge(u,v,w); }
+            {
+                auto lk = lock_graph(*cur);
+                ok = cur->g.addEdge(u,v,w);
+                if (ok) { trace::Scope t("alt_repair"); cur->alt.onEdgeAdded(cur->g,u,v,w); }
+            }
             if (!ok) fprintf(fp, "ERR no such node\n"); else fprintf(fp, "OK\n");
-            fflush(fp);
+            flush_reply(fp);
 
         } else if (op == "BFS") {
-            int s; if (!(iss >> s)) { fprintf(fp, "ERR bad args\n"); fflush(fp); continue; }
+            int s; if (!(iss >> s)) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
             std::vector<int> order;
-            { std::lock_guard<std::mutex> lk(G_MTX); order = G.bfs(s); }
-            if (order.empty()) { fprintf(fp, "EMPTY\n"); fflush(fp); continue; }
-            for (size_t i=0; i<order.size(); ++i) fprintf(fp, "%d%c", order[i], (i+1==order.size()?'\n':' '));
-            fflush(fp);
+            { auto lk = lock_graph(*cur); trace::Scope t("bfs"); order = cur->g.bfs(s); }
+            if (order.empty()) { fprintf(fp, "EMPTY\n"); flush_reply(fp); continue; }
+            {
+                trace::Scope w("format", (int64_t)order.size());
+                for (size_t i=0; i<order.size(); ++i) fprintf(fp, "%d%c", order[i], (i+1==order.size()?'\n':' '));
+            }
+            flush_reply(fp);
 
         } else if (op == "SHORTEST_PATH") {
-            int s,d; if (!(iss >> s >> d)) { fprintf(fp, "ERR bad args\n"); fflush(fp); continue; }
-            auto ans = [&](){ std::lock_guard<std::mutex> lk(G_MTX); return G.shortestPathUnweighted(s,d);}();
+            int s,d; if (!(iss >> s >> d)) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
+            std::string mode; iss >> mode;
+            if (mode == "W") {
+                // weighted: A* with landmark bounds (falls back to Dijkstra until ALT_BUILD ran)
+                auto ans = [&](){ auto lk = lock_graph(*cur); trace::Scope t("alt_query"); return cur->alt.shortestPath(cur->g,s,d);}();
+                if (!ans) fprintf(fp, "UNREACHABLE\n"); else fprintf(fp, "%lld\n", *ans);
+                flush_reply(fp); continue;
+            }
+            auto ans = [&](){ auto lk = lock_graph(*cur); trace::Scope t("shortest_path"); return cur->g.shortestPathUnweighted(s,d);}();
             if (!ans) fprintf(fp, "UNREACHABLE\n"); else fprintf(fp, "%d\n", *ans);
-            fflush(fp);
+            flush_reply(fp);
+
+        } else if (op == "ALT_BUILD") {
+            size_t k = 8; std::string strat = "farthest";
+            std::string tok;
+            if (iss >> tok) {
+                // both arguments are optional, so the first token may already be the strategy
+                if (isdigit((unsigned char)tok[0])) {
+                    char* end = nullptr;
+                    k = std::strtoul(tok.c_str(), &end, 10);
+                    if (*end) k = 0; // trailing junk -> bad args
+                    iss >> strat;
+                } else {
+                    strat = tok;
+                }
+            }
+            if (k == 0 || k > AltIndex::MAX_LANDMARKS || (strat != "farthest" && strat != "degree")) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
+            auto st = strat == "degree" ? AltIndex::Strategy::DEGREE : AltIndex::Strategy::FARTHEST;
+            bool started;
+            { auto lk = lock_graph(*cur); started = cur->alt.buildAsync(cur->g, cur->mtx, k, st, cur); }
+            if (!started) fprintf(fp, "ERR busy\n"); else fprintf(fp, "OK building\n");
+            flush_reply(fp);
+
+        } else if (op == "ALT_STATS") {
+            AltIndex::Stats st;
+            { auto lk = lock_graph(*cur); st = cur->alt.stats(); }
+            fprintf(fp, "state=%s k=%zu prep_ms=%.2f bytes=%zu repairs=%zu landmarks=",
+                    st.state.c_str(), st.landmarks.size(), st.prepMs, st.bytes, st.repairs);
+            for (size_t i=0; i<st.landmarks.size(); ++i) fprintf(fp, "%s%d", (i?",":""), st.landmarks[i]);
+            if (!st.error.empty()) fprintf(fp, " error=%s", st.error.c_str());
+            fprintf(fp, "\n");
+            flush_reply(fp);
+
+        } else if (op == "SCC") {
+            std::string flag; iss >> flag;
+            if (!flag.empty() && flag != "IDS") { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
+            SccResult res = strongComponents(cur->g, cur->mtx, ALGO_POOL, flag == "IDS");
+            fprintf(fp, "count=%d largest=%d", res.count, res.largest);
+            if (flag == "IDS") {
+                trace::Scope w("format", (int64_t)res.ids.size());
+                fprintf(fp, " ids=");
+                for (size_t i=0; i<res.ids.size(); ++i) fprintf(fp, "%s%d:%d", (i?",":""), res.ids[i].first, res.ids[i].second);
+            }
+            fprintf(fp, "\n");
+            flush_reply(fp);
+
+        } else if (op == "USE") {
+            std::string name; iss >> name;
+            auto e = REGISTRY.get(name);
+            if (!e) { fprintf(fp, "ERR no such graph\n"); flush_reply(fp); continue; }
+            cur = e;
+            fprintf(fp, "OK\n"); flush_reply(fp);
+
+        } else if (op == "CREATE") {
+            std::string name; iss >> name;
+            if (!GraphRegistry::validName(name)) { fprintf(fp, "ERR bad name\n"); flush_reply(fp); continue; }
+            if (!REGISTRY.create(name)) fprintf(fp, "ERR exists\n"); else fprintf(fp, "OK\n");
+            flush_reply(fp);
+
+        } else if (op == "DROP") {
+            std::string name; iss >> name;
+            if (!REGISTRY.drop(name)) fprintf(fp, "ERR no such graph\n"); else fprintf(fp, "OK\n");
+            flush_reply(fp);
+
+        } else if (op == "LOAD") {
+            // Clients name a file, not a path: <file>.txt inside LOAD_DIR.
+            std::string name, file;
+            if (!(iss >> name >> file)) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
+            if (!GraphRegistry::validName(name) || !GraphRegistry::validName(file)) { fprintf(fp, "ERR bad name\n"); flush_reply(fp); continue; }
+            std::string path = LOAD_DIR + "/" + file + ".txt";
+            // Parse without any lock held; only the swap blocks users of this graph.
+            std::string err;
+            size_t edges = 0;
+            std::optional<Graph> loaded;
+            { trace::Scope t("load_parse"); loaded = loadGraphFile(path, edges, err); }
+            if (!loaded) { fprintf(fp, "ERR %s\n", err.c_str()); flush_reply(fp); continue; }
+            size_t nodes = loaded->nodeCount();
+            auto e = REGISTRY.getOrCreate(name);
+            {
+                auto lk = lock_graph(*e);
+                std::swap(e->g, *loaded);
+                e->alt.reset();
+            }
+            loaded.reset(); // free the old contents outside the lock
+            fprintf(fp, "OK nodes=%zu edges=%zu\n", nodes, edges);
+            flush_reply(fp);
+
+        } else if (op == "GRAPHS") {
+            size_t total = 0;
+            for (const auto& e : REGISTRY.list()) {
+                size_t nodes, arcs, bytes;
+                { auto lk = lock_graph(*e); nodes = e->g.nodeCount(); arcs = e->g.edgeCount(); bytes = e->memoryBytes(); }
+                total += bytes;
+                // arcs: directed adjacency entries, so a LOADed undirected edge counts twice
+                fprintf(fp, "%s%s:nodes=%zu,arcs=%zu,bytes=%zu ", (e == cur ? "*" : ""),
+                        e->name.c_str(), nodes, arcs, bytes);
+            }
+            fprintf(fp, "total_bytes=%zu\n", total);
+            flush_reply(fp);
+
+        } else if (op == "TRACE") {
+            std::string sub; iss >> sub;
+            if (sub == "ON") {
+                double rate = 1.0;
+                if (!(iss >> rate)) rate = 1.0;
+                if (!(rate > 0 && rate <= 1)) { fprintf(fp, "ERR bad args\n"); flush_reply(fp); continue; }
+                trace::enable(rate);
+                fprintf(fp, "OK tracing rate=%g\n", rate);
+            } else if (sub == "OFF") {
+                trace::disable();
+                fprintf(fp, "OK\n");
+            } else if (sub == "DUMP") {
+                // Clients only pick a file name; the directory is fixed at server start.
+                std::string name;
+                if (!(iss >> name) || !GraphRegistry::validName(name)) { fprintf(fp, "ERR bad name\n"); flush_reply(fp); continue; }
+                std::string path = TRACE_DIR + "/" + name + ".json";
+                long count = trace::dump(path);
+                if (count < 0) fprintf(fp, "ERR cannot write %s\n", path.c_str());
+                else fprintf(fp, "OK %ld events\n", count);
+            } else {
+                fprintf(fp, "ERR bad args\n");
+            }
+            flush_reply(fp);
 
         } else {
             print_unknown(fp);
@@ -83,6 +268,10 @@ static void handle_client(int client_fd) {
 int main(int argc, char** argv) {
     int port = 5000;
     if (argc >= 2) port = std::stoi(argv[1]);
+    if (argc >= 3) TRACE_DIR = argv[2];
+    else if (const char* dir = getenv("TRACE_DIR")) TRACE_DIR = dir;
+    if (argc >= 4) LOAD_DIR = argv[3];
+    else if (const char* dir = getenv("LOAD_DIR")) LOAD_DIR = dir;
 
     int srv = socket(AF_INET, SOCK_STREAM, 0);
     if (srv < 0) { perror("socket"); return 1; }
@@ -92,13 +281,16 @@ int main(int argc, char** argv) {
     if (bind(srv, (sockaddr*)&addr, sizeof(addr)) != 0) { perror("bind"); return 1; }
     if (listen(srv, 64) != 0) { perror("listen"); return 1; }
 
+    REGISTRY.create("default"); // new sessions start on this graph
     std::cout << "Part3 server listening on " << port << std::endl;
 
-    ThreadPool pool(4); // 4 workers; change if needed
+    ThreadPool pool(4, "conn"); // 4 workers; change if needed
+    trace::setThreadName("acceptor");
 
     while (true) {
         int cfd = accept(srv, nullptr, nullptr);
         if (cfd < 0) { perror("accept"); continue; }
+        trace::sample(); // traces how long the connection waits for a free worker
         pool.submit([cfd]{ handle_client(cfd); });
     }
 }
@@ -0,0 +1,277 @@
+#include "alt.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <tuple>
+
+static const long long INF = std::numeric_limits<long long>::max() / 4;
+
+// Dijkstra over a dense adjacency, writing d(src, x) into out[x * stride + off].
+static void sssp(const std::vector<std::vector<std::pair<int,int>>>& a, size_t src,
+                 std::vector<long long>& out, size_t stride, size_t off) {
+    using P = std::pair<long long,int>;
+    std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+    out[src * stride + off] = 0; pq.push({0, (int)src});
+    while (!pq.empty()) {
+        auto [d, u] = pq.top(); pq.pop();
+        if (d != out[u * stride + off]) continue;
+        for (auto [v, w] : a[u]) {
+            long long& dv = out[v * stride + off];
+            if (dv > d + w) { dv = d + w; pq.push({dv, v}); }
+        }
+    }
+}
+
+void AltIndex::compute(Tables& t, const Adj& fwd, size_t k, Strategy s) {
+    size_t n = t.ids.size();
+    k = std::min(k, n);
+    t.k = k;
+    t.from.assign(n * k, INF);
+    t.to.assign(n * k, INF);
+    t.landmarks.clear();
+    if (k == 0) return;
+
+    auto deg = [&](size_t x) { return fwd[x].size() + t.radj[x].size(); };
+    std::vector<size_t> chosen;
+
+    if (s == Strategy::DEGREE) {
+        std::vector<size_t> order(n);
+        for (size_t x = 0; x < n; ++x) order[x] = x;
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                          [&](size_t a, size_t b) { return deg(a) > deg(b); });
+        chosen.assign(order.begin(), order.begin() + k);
+        for (size_t i = 0; i < k; ++i) {
+            sssp(fwd, chosen[i], t.from, k, i);
+            sssp(t.radj, chosen[i], t.to, k, i);
+        }
+    } else {
+        // Farthest-point: start at the highest-degree node, then repeatedly take the node
+        // whose round-trip distance to the closest chosen landmark is largest.
+        // Unreachable nodes count as very far so disconnected parts get their own landmark.
+        const long long FAR = INF / 4;
+        std::vector<long long> score(n, INF);
+        size_t next = 0;
+        for (size_t x = 1; x < n; ++x) if (deg(x) > deg(next)) next = x;
+        for (size_t i = 0; i < k; ++i) {
+            chosen.push_back(next);
+            sssp(fwd, next, t.from, k, i);
+            sssp(t.radj, next, t.to, k, i);
+            size_t best = 0;
+            for (size_t x = 0; x < n; ++x) {
+                long long f = t.from[x * k + i], b = t.to[x * k + i];
+                long long round = (f >= INF ? FAR : f) + (b >= INF ? FAR : b);
+                score[x] = std::min(score[x], round);
+                if (score[x] > score[best]) best = x;
+            }
+            next = best;
+        }
+    }
+    for (size_t x : chosen) t.landmarks.push_back(t.ids[x]);
+}
+
+size_t AltIndex::ensure(Tables& t, int id) {
+    auto it = t.idx.find(id);
+    if (it != t.idx.end()) return it->second;
+    size_t x = t.ids.size();
+    t.idx[id] = (int)x;
+    t.ids.push_back(id);
+    t.radj.emplace_back();
+    t.from.resize(t.from.size() + t.k, INF);
+    t.to.resize(t.to.size() + t.k, INF);
+    return x;
+}
+
+// Edges are only ever added, so distances can only shrink: seed the decrease at the
+// new edge and propagate it Dijkstra-style through the affected region only.
+void AltIndex::repair(Tables& t, const Graph& g, int u, int v, int w) {
+    size_t ui = ensure(t, u), vi = ensure(t, v), k = t.k;
+    t.radj[vi].push_back({(int)ui, w});
+    using P = std::pair<long long,size_t>;
+    const auto& adj = g.adjacency();
+
+    for (size_t i = 0; i < k; ++i) {
+        // d(L_i, .) through u->v, spread along forward edges
+        std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+        if (t.from[ui * k + i] < INF && t.from[ui * k + i] + w < t.from[vi * k + i]) {
+            t.from[vi * k + i] = t.from[ui * k + i] + w;
+            pq.push({t.from[vi * k + i], vi});
+        }
+        while (!pq.empty()) {
+            auto [d, x] = pq.top(); pq.pop();
+            if (d != t.from[x * k + i]) continue;
+            auto it = adj.find(t.ids[x]);
+            if (it == adj.end()) continue;
+            for (auto [y, wy] : it->second) {
+                size_t yi = ensure(t, y);
+                if (t.from[yi * k + i] > d + wy) {
+                    t.from[yi * k + i] = d + wy;
+                    pq.push({d + wy, yi});
+                }
+            }
+        }
+
+        // d(., L_i) through u->v, spread along reverse edges
+        if (t.to[vi * k + i] < INF && t.to[vi * k + i] + w < t.to[ui * k + i]) {
+            t.to[ui * k + i] = t.to[vi * k + i] + w;
+            pq.push({t.to[ui * k + i], ui});
+        }
+        while (!pq.empty()) {
+            auto [d, x] = pq.top(); pq.pop();
+            if (d != t.to[x * k + i]) continue;
+            for (auto [y, wy] : t.radj[x]) {
+                if (t.to[y * k + i] > d + wy) {
+                    t.to[y * k + i] = d + wy;
+                    pq.push({d + wy, (size_t)y});
+                }
+            }
+        }
+    }
+}
+
+size_t AltIndex::bytesOf(const Tables& t) {
+    size_t b = (t.from.capacity() + t.to.capacity()) * sizeof(long long);
+    b += t.ids.capacity() * sizeof(int) + t.landmarks.capacity() * sizeof(int);
+    b += t.idx.size() * (sizeof(std::pair<const int,int>) + 2 * sizeof(void*));
+    b += t.idx.bucket_count() * sizeof(void*);
+    for (const auto& r : t.radj) b += sizeof(r) + r.capacity() * sizeof(r[0]);
+    return b;
+}
+
+bool AltIndex::buildAsync(const Graph& g, std::mutex& gm, size_t k, Strategy s,
+                          std::shared_ptr<void> keepAlive) {
+    if (building_ || k == 0 || k > MAX_LANDMARKS) return false;
+    building_ = true;
+    pending_.clear();
+
+    // Snapshot under the caller's lock; the expensive part runs without it.
+    auto t = std::make_shared<Tables>();
+    auto fwd = std::make_shared<Adj>();
+    for (const auto& [id, out] : g.adjacency()) { (void)out; ensure(*t, id); }
+    fwd->resize(t->ids.size());
+    for (const auto& [id, out] : g.adjacency()) {
+        int u = t->idx[id];
+        for (auto [v, w] : out) {
+            (*fwd)[u].push_back({t->idx[v], w});
+            t->radj[t->idx[v]].push_back({u, w});
+        }
+    }
+
+    unsigned gen = generation_;
+    std::thread([this, &g, &gm, t, fwd, k, s, gen, keepAlive] {
+        // An exception escaping a detached thread would terminate the server.
+        bool installed = false;
+        try {
+            auto t0 = std::chrono::steady_clock::now();
+            compute(*t, *fwd, k, s);
+            t->prepMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+            std::lock_guard<std::mutex> lk(gm);
+            if (gen != generation_) return; // graph replaced meanwhile
+            cur_ = std::move(*t);
+            installed = true;
+            repairs_ = 0;
+            for (const auto& e : pending_) { repair(cur_, g, e.u, e.v, e.w); ++repairs_; }
+            pending_.clear();
+            ready_ = true;
+            building_ = false;
+            error_.clear();
+        } catch (const std::exception& ex) {
+            std::lock_guard<std::mutex> lk(gm);
+            if (gen != generation_) return;
+            // Old tables stay exact (edges added meanwhile were repaired into them) unless
+            // the failure came after the new, partly repaired tables replaced them.
+            if (installed) { cur_ = Tables(); ready_ = false; }
+            pending_.clear();
+            building_ = false;
+            error_ = ex.what();
+        }
+    }).detach();
+    return true;
+}
+
+void AltIndex::reset() {
+    cur_ = Tables();
+    ready_ = false;
+    building_ = false;
+    repairs_ = 0;
+    pending_.clear();
+    error_.clear();
+    ++generation_;
+}
+
+void AltIndex::onEdgeAdded(const Graph& g, int u, int v, int w) {
+    if (building_) pending_.push_back({u, v, w});
+    if (ready_) { repair(cur_, g, u, v, w); ++repairs_; }
+}
+
+// max over landmarks of the two triangle-inequality bounds; INF means dst is provably unreachable.
+long long AltIndex::heuristic(size_t x, size_t dst) const {
+    size_t k = cur_.k;
+    long long h = 0;
+    for (size_t i = 0; i < k; ++i) {
+        long long fx = cur_.from[x * k + i], ft = cur_.from[dst * k + i];
+        long long tx = cur_.to[x * k + i], tt = cur_.to[dst * k + i];
+        if (fx < INF && ft >= INF) return INF;   // L reaches x but not dst
+        if (tt < INF && tx >= INF) return INF;   // dst reaches L but x does not
+        if (fx < INF && ft < INF) h = std::max(h, ft - fx);
+        if (tx < INF && tt < INF) h = std::max(h, tx - tt);
+    }
+    return h;
+}
+
+std::optional<long long> AltIndex::shortestPath(const Graph& g, int src, int dst) const {
+    if (!g.hasNode(src) || !g.hasNode(dst)) return std::nullopt;
+
+    bool useAlt = ready_ && cur_.k > 0;
+    size_t di = 0;
+    if (useAlt) {
+        auto it = cur_.idx.find(dst);
+        if (it == cur_.idx.end()) useAlt = false; else di = it->second;
+    }
+    auto h = [&](int v) -> long long {
+        if (!useAlt) return 0;
+        auto it = cur_.idx.find(v);
+        return it == cur_.idx.end() ? 0 : heuristic(it->second, di);
+    };
+
+    using T = std::tuple<long long, long long, int>; // (f, g, node)
+    std::priority_queue<T, std::vector<T>, std::greater<T>> pq;
+    std::unordered_map<int, long long> dist;
+    const auto& adj = g.adjacency();
+    long long h0 = h(src);
+    if (h0 >= INF) return std::nullopt;
+    dist[src] = 0; pq.push({h0, 0, src});
+    while (!pq.empty()) {
+        auto [f, d, u] = pq.top(); pq.pop();
+        (void)f;
+        if (d != dist[u]) continue;
+        if (u == dst) return d;
+        auto it = adj.find(u);
+        if (it == adj.end()) continue;
+        for (auto [v, w] : it->second) {
+            long long nd = d + w;
+            auto dv = dist.find(v);
+            if (dv != dist.end() && dv->second <= nd) continue;
+            long long hv = h(v);
+            if (hv >= INF) continue;
+            dist[v] = nd;
+            pq.push({nd + hv, nd, v});
+        }
+    }
+    return std::nullopt;
+}
+
+AltIndex::Stats AltIndex::stats() const {
+    Stats s;
+    s.state = ready_ ? (building_ ? "ready+building" : "ready") :
+              building_ ? "building" : error_.empty() ? "none" : "failed";
+    s.error = error_;
+    if (ready_) {
+        s.landmarks = cur_.landmarks;
+        s.prepMs = cur_.prepMs;
+        s.bytes = bytesOf(cur_);
+    }
+    s.repairs = repairs_;
+    return s;
+}
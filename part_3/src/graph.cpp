@@ -14,9 +14,21 @@ bool Graph::hasNode(int id) const {
 bool Graph::addEdge(int u, int v, int w) {
     if (!hasNode(u) || !hasNode(v)) return false; // enforce existence
     adj[u].push_back({v, w});
+    ++numEdges;
     return true;
 }
 
+size_t Graph::memoryBytes() const {
+    // buckets + one heap node per vertex (key/value plus next pointer) + edge storage
+    size_t b = adj.bucket_count() * sizeof(void*);
+    for (const auto& [id, out] : adj) {
+        (void)id;
+        b += sizeof(std::pair<const int, std::vector<std::pair<int,int>>>) + sizeof(void*);
+        b += out.capacity() * sizeof(std::pair<int,int>);
+    }
+    return b;
+}
+
 std::vector<int> Graph::bfs(int src) const {
     std::unordered_map<int, bool> vis;
     std::queue<int> q;
@@ -0,0 +1,100 @@
+#include "graph_registry.hpp"
+#include <climits>
+#include <cmath>
+#include <sys/stat.h>
+#include <fstream>
+#include <sstream>
+
+bool GraphRegistry::validName(const std::string& name) {
+    if (name.empty() || name.size() > 64) return false;
+    for (char c : name)
+        if (!(isalnum((unsigned char)c) || c == '_' || c == '-')) return false;
+    return true;
+}
+
+std::shared_ptr<GraphEntry> GraphRegistry::create(const std::string& name) {
+    if (!validName(name)) return nullptr;
+    std::lock_guard<std::mutex> lk(m_);
+    auto& slot = graphs_[name];
+    if (slot) return nullptr;
+    slot = std::make_shared<GraphEntry>(name);
+    return slot;
+}
+
+std::shared_ptr<GraphEntry> GraphRegistry::getOrCreate(const std::string& name) {
+    if (!validName(name)) return nullptr;
+    std::lock_guard<std::mutex> lk(m_);
+    auto& slot = graphs_[name];
+    if (!slot) slot = std::make_shared<GraphEntry>(name);
+    return slot;
+}
+
+std::shared_ptr<GraphEntry> GraphRegistry::get(const std::string& name) const {
+    std::lock_guard<std::mutex> lk(m_);
+    auto it = graphs_.find(name);
+    return it == graphs_.end() ? nullptr : it->second;
+}
+
+bool GraphRegistry::drop(const std::string& name) {
+    std::shared_ptr<GraphEntry> e;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        auto it = graphs_.find(name);
+        if (it == graphs_.end()) return false;
+        e = it->second;
+        graphs_.erase(it);
+    }
+    // Free the contents now rather than when the last session lets go.
+    std::lock_guard<std::mutex> lk(e->mtx);
+    e->dropped = true;
+    e->g = Graph();
+    e->alt.reset();
+    return true;
+}
+
+std::vector<std::shared_ptr<GraphEntry>> GraphRegistry::list() const {
+    std::lock_guard<std::mutex> lk(m_);
+    std::vector<std::shared_ptr<GraphEntry>> out;
+    for (const auto& [name, e] : graphs_) { (void)name; out.push_back(e); }
+    return out;
+}
+
+std::optional<Graph> loadGraphFile(const std::string& path, size_t& edges, std::string& err) {
+    // FIFOs and devices could block the connection worker forever.
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) { err = "cannot open " + path; return std::nullopt; }
+    std::ifstream in(path);
+    if (!in) { err = "cannot open " + path; return std::nullopt; }
+
+    char typ; long long n, m;
+    if (!(in >> typ >> n >> m) || (typ != 'U' && typ != 'D') || n < 0 || m < 0) {
+        err = "invalid header (expected: U|D N M)";
+        return std::nullopt;
+    }
+    if (n > LOAD_MAX_NODES) {
+        err = "too many nodes (limit " + std::to_string(LOAD_MAX_NODES) + ")";
+        return std::nullopt;
+    }
+    Graph g;
+    for (long long i = 0; i < n; ++i) g.addNode((int)i);
+
+    std::string line;
+    std::getline(in, line); // rest of the header line
+    for (long long i = 0; i < m; ) {
+        if (!std::getline(in, line)) { err = "expected " + std::to_string(m) + " edges, got " + std::to_string(i); return std::nullopt; }
+        std::istringstream ls(line);
+        int u, v; double w = 1.0;
+        if (!(ls >> u)) continue; // blank line
+        if (!(ls >> v)) { err = "invalid edge line " + std::to_string(i + 1); return std::nullopt; }
+        if (!(ls >> w)) w = 1.0;
+        if (!(w >= 0 && w <= INT_MAX)) { err = "bad weight on edge line " + std::to_string(i + 1); return std::nullopt; }
+        int wi = (int)std::lround(w);
+        if (!g.addEdge(u, v, wi) || (typ == 'U' && u != v && !g.addEdge(v, u, wi))) {
+            err = "edge " + std::to_string(u) + " " + std::to_string(v) + " out of range";
+            return std::nullopt;
+        }
+        ++i;
+    }
+    edges = (size_t)m;
+    return g;
+}
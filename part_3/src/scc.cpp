@@ -0,0 +1,234 @@
+#include "scc.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "trace.hpp"
+
+namespace {
+
+const size_t SMALL_GRAPH = 4096;   // whole graph below this: sequential Tarjan
+const size_t SMALL_PART = 1024;    // sub-problem below this: Tarjan inside the task
+
+struct Csr {
+    std::vector<int> off, adj;
+};
+
+// Each vertex belongs to exactly one sub-problem (its color) and only the task owning
+// that color writes its per-vertex fields, so only color itself needs to be atomic.
+struct SccState {
+    Csr fwd, rev;
+    std::vector<std::atomic<int>> color; // -1 once the vertex has a component
+    std::vector<int> comp, tidx, tlow, din, dout;
+    std::vector<char> onstack;
+    std::atomic<int> nextColor{1}, nextComp{0};
+    ThreadPool* pool = nullptr;
+    WaitGroup wg;
+
+    explicit SccState(size_t n)
+      : color(n), comp(n, -1), tidx(n, -1), tlow(n, 0), din(n, 0), dout(n, 0), onstack(n, 0) {
+        for (auto& c : color) c.store(0, std::memory_order_relaxed);
+    }
+
+    int col(int v) const { return color[v].load(std::memory_order_relaxed); }
+    void assign(int v, int id) { comp[v] = id; color[v].store(-1, std::memory_order_relaxed); }
+};
+
+// Iterative Tarjan restricted to the vertices of V that still have color c.
+void tarjan(SccState& st, const std::vector<int>& V, int c) {
+    int counter = 0;
+    std::vector<int> stack;
+    std::vector<std::pair<int,int>> call; // (vertex, next edge position)
+    auto open = [&](int v) {
+        st.tidx[v] = st.tlow[v] = counter++;
+        stack.push_back(v); st.onstack[v] = 1;
+        call.push_back({v, st.fwd.off[v]});
+    };
+
+    for (int r : V) {
+        if (st.col(r) != c || st.tidx[r] != -1) continue;
+        open(r);
+        while (!call.empty()) {
+            int v = call.back().first;
+            int& pos = call.back().second;
+            if (pos < st.fwd.off[v + 1]) {
+                int w = st.fwd.adj[pos++];
+                if (st.col(w) != c) continue;
+                if (st.tidx[w] == -1) open(w);
+                else if (st.onstack[w]) st.tlow[v] = std::min(st.tlow[v], st.tidx[w]);
+                continue;
+            }
+            call.pop_back();
+            if (!call.empty()) {
+                int p = call.back().first;
+                st.tlow[p] = std::min(st.tlow[p], st.tlow[v]);
+            }
+            if (st.tlow[v] == st.tidx[v]) {
+                int id = st.nextComp++;
+                int x;
+                do {
+                    x = stack.back(); stack.pop_back();
+                    st.onstack[x] = 0;
+                    st.assign(x, id);
+                } while (x != v);
+            }
+        }
+    }
+}
+
+// Peels vertices with no in- or out-edges inside color c; each is a singleton SCC.
+// Returns the vertices of V that survive.
+std::vector<int> trim(SccState& st, const std::vector<int>& V, int c) {
+    std::vector<int> queue;
+    for (int v : V) {
+        int o = 0, i = 0;
+        for (int p = st.fwd.off[v]; p < st.fwd.off[v + 1]; ++p) o += st.col(st.fwd.adj[p]) == c;
+        for (int p = st.rev.off[v]; p < st.rev.off[v + 1]; ++p) i += st.col(st.rev.adj[p]) == c;
+        st.dout[v] = o; st.din[v] = i;
+        if (o == 0 || i == 0) queue.push_back(v);
+    }
+    for (size_t h = 0; h < queue.size(); ++h) {
+        int v = queue[h];
+        if (st.col(v) != c) continue;
+        st.assign(v, st.nextComp++);
+        for (int p = st.fwd.off[v]; p < st.fwd.off[v + 1]; ++p) {
+            int w = st.fwd.adj[p];
+            if (st.col(w) == c && --st.din[w] == 0) queue.push_back(w);
+        }
+        for (int p = st.rev.off[v]; p < st.rev.off[v + 1]; ++p) {
+            int w = st.rev.adj[p];
+            if (st.col(w) == c && --st.dout[w] == 0) queue.push_back(w);
+        }
+    }
+    std::vector<int> rest;
+    for (int v : V) if (st.col(v) == c) rest.push_back(v);
+    return rest;
+}
+
+void solve(SccState& st, std::vector<int> V, int c);
+
+void spawn(SccState& st, std::vector<int> V, int c) {
+    if (V.empty()) return;
+    st.wg.add();
+    st.pool->submit([&st, V = std::move(V), c]() mutable {
+        solve(st, std::move(V), c);
+        st.wg.done();
+    });
+}
+
+// Forward-backward step: the SCC of a pivot is fw(pivot) ∩ bw(pivot); the three
+// remainders (fw only, bw only, neither) cannot share an SCC and are solved in parallel.
+void solve(SccState& st, std::vector<int> V, int c) {
+    trace::Scope t("scc_part", (int64_t)V.size());
+    V = trim(st, V, c);
+    if (V.empty()) return;
+    if (V.size() <= SMALL_PART) { tarjan(st, V, c); return; }
+
+    int pivot = V[0];
+    long long best = -1;
+    for (int v : V) {
+        long long score = 1LL * st.din[v] * st.dout[v];
+        if (score > best) { best = score; pivot = v; }
+    }
+
+    int cf = st.nextColor++, cb = st.nextColor++;
+    std::vector<int> q{pivot};
+    st.color[pivot].store(cf, std::memory_order_relaxed);
+    for (size_t h = 0; h < q.size(); ++h) {
+        int v = q[h];
+        for (int p = st.fwd.off[v]; p < st.fwd.off[v + 1]; ++p) {
+            int w = st.fwd.adj[p];
+            if (st.col(w) == c) { st.color[w].store(cf, std::memory_order_relaxed); q.push_back(w); }
+        }
+    }
+
+    int id = st.nextComp++;
+    q.assign(1, pivot);
+    st.assign(pivot, id);
+    for (size_t h = 0; h < q.size(); ++h) {
+        int v = q[h];
+        for (int p = st.rev.off[v]; p < st.rev.off[v + 1]; ++p) {
+            int w = st.rev.adj[p];
+            int cw = st.col(w);
+            if (cw == cf) { st.assign(w, id); q.push_back(w); }
+            else if (cw == c) { st.color[w].store(cb, std::memory_order_relaxed); q.push_back(w); }
+        }
+    }
+
+    std::vector<int> fOnly, bOnly, rest;
+    for (int v : V) {
+        int cv = st.col(v);
+        if (cv == cf) fOnly.push_back(v);
+        else if (cv == cb) bOnly.push_back(v);
+        else if (cv == c) rest.push_back(v);
+    }
+    spawn(st, std::move(fOnly), cf);
+    spawn(st, std::move(bOnly), cb);
+    spawn(st, std::move(rest), c);
+}
+
+} // namespace
+
+SccResult strongComponents(const Graph& g, std::mutex& gm, ThreadPool& pool, bool withIds) {
+    std::vector<int> ids;
+    std::unique_ptr<SccState> st;
+    {
+        std::unique_lock<std::mutex> lk = [&] {
+            trace::Scope w("graph lock wait");
+            return std::unique_lock<std::mutex>(gm);
+        }();
+        trace::Scope snap("scc_snapshot");
+        const auto& adj = g.adjacency();
+        std::unordered_map<int, int> idx;
+        ids.reserve(adj.size());
+        for (const auto& [id, out] : adj) { (void)out; idx[id] = (int)ids.size(); ids.push_back(id); }
+
+        size_t n = ids.size();
+        st.reset(new SccState(n));
+        st->fwd.off.assign(n + 1, 0);
+        st->rev.off.assign(n + 1, 0);
+        for (const auto& [id, out] : adj) {
+            st->fwd.off[idx[id] + 1] += (int)out.size();
+            for (auto [v, w] : out) { (void)w; st->rev.off[idx[v] + 1]++; }
+        }
+        for (size_t x = 0; x < n; ++x) {
+            st->fwd.off[x + 1] += st->fwd.off[x];
+            st->rev.off[x + 1] += st->rev.off[x];
+        }
+        st->fwd.adj.resize(st->fwd.off[n]);
+        st->rev.adj.resize(st->rev.off[n]);
+        std::vector<int> fpos(st->fwd.off.begin(), st->fwd.off.end() - 1);
+        std::vector<int> rpos(st->rev.off.begin(), st->rev.off.end() - 1);
+        for (const auto& [id, out] : adj) {
+            int u = idx[id];
+            for (auto [v, w] : out) {
+                (void)w;
+                int vi = idx[v];
+                st->fwd.adj[fpos[u]++] = vi;
+                st->rev.adj[rpos[vi]++] = u;
+            }
+        }
+    }
+
+    size_t n = ids.size();
+    trace::Scope solveScope("scc_solve", (int64_t)n);
+    std::vector<int> all(n);
+    for (size_t x = 0; x < n; ++x) all[x] = (int)x;
+    if (n <= SMALL_GRAPH) {
+        tarjan(*st, all, 0);
+    } else {
+        st->pool = &pool;
+        spawn(*st, std::move(all), 0);
+        st->wg.wait();
+    }
+
+    SccResult res;
+    res.count = st->nextComp.load();
+    std::vector<int> size(res.count, 0);
+    for (size_t x = 0; x < n; ++x) res.largest = std::max(res.largest, ++size[st->comp[x]]);
+    if (withIds) {
+        res.ids.reserve(n);
+        for (size_t x = 0; x < n; ++x) res.ids.push_back({ids[x], st->comp[x]});
+        std::sort(res.ids.begin(), res.ids.end());
+    }
+    return res;
+}
@@ -0,0 +1,157 @@
+#include "trace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+namespace {
+
+const size_t RING_CAPACITY = 1 << 14; // events per thread
+
+// Slots are relaxed atomics so a concurrent dump never reads a torn value; head is
+// published with release after the slot is written.
+struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> ts{0}, dur{0};
+    std::atomic<int64_t> arg{-1};
+};
+
+struct Ring {
+    int tid = 0;
+    std::string name;                 // guarded by registryMtx
+    std::atomic<uint64_t> head{0};    // total events ever written
+    std::unique_ptr<Slot[]> slots{new Slot[RING_CAPACITY]};
+};
+
+std::atomic<bool> gEnabled{false};
+std::atomic<uint32_t> gThreshold{0}; // sample if rng < threshold (2^32 * rate)
+std::atomic<double> gRate{0};
+
+std::mutex registryMtx;
+std::vector<std::shared_ptr<Ring>> registry; // rings outlive their threads until exit
+
+thread_local uint32_t tRng = 0;
+thread_local Ring* tRing = nullptr;
+thread_local std::string tName;
+
+Ring* ring() {
+    if (tRing) return tRing;
+    auto r = std::make_shared<Ring>();
+    std::lock_guard<std::mutex> lk(registryMtx);
+    r->tid = (int)registry.size() + 1;
+    r->name = tName.empty() ? "thread-" + std::to_string(r->tid) : tName;
+    registry.push_back(r);
+    tRing = r.get();
+    return tRing;
+}
+
+uint32_t nextRandom() {
+    if (tRng == 0) tRng = (uint32_t)(nowNs() | 1) ^ (uint32_t)(uintptr_t)&tRng;
+    tRng ^= tRng << 13; tRng ^= tRng >> 17; tRng ^= tRng << 5; // xorshift32
+    return tRng;
+}
+
+void writeEscaped(FILE* f, const std::string& s) {
+    for (char c : s) {
+        if (c == '"' || c == '\\') fputc('\\', f);
+        if ((unsigned char)c >= 0x20) fputc(c, f);
+    }
+}
+
+} // namespace
+
+uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void enable(double r) {
+    if (r <= 0) { disable(); return; }
+    if (r > 1) r = 1;
+    gRate.store(r, std::memory_order_relaxed);
+    gThreshold.store(r >= 1 ? UINT32_MAX : (uint32_t)(r * 4294967296.0), std::memory_order_relaxed);
+    gEnabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+    gEnabled.store(false, std::memory_order_relaxed);
+    gRate.store(0, std::memory_order_relaxed);
+}
+
+bool enabled() { return gEnabled.load(std::memory_order_relaxed); }
+double rate() { return gRate.load(std::memory_order_relaxed); }
+
+bool sample() {
+    if (!gEnabled.load(std::memory_order_relaxed)) return detail::tSampled = false;
+    return detail::tSampled = nextRandom() <= gThreshold.load(std::memory_order_relaxed);
+}
+
+void setThreadName(const std::string& name) {
+    tName = name;
+    if (tRing) {
+        std::lock_guard<std::mutex> lk(registryMtx);
+        tRing->name = name;
+    }
+}
+
+void record(const char* name, uint64_t startNs, uint64_t durNs, int64_t arg) {
+    Ring* r = ring();
+    uint64_t h = r->head.load(std::memory_order_relaxed);
+    Slot& s = r->slots[h % RING_CAPACITY];
+    s.name.store(name, std::memory_order_relaxed);
+    s.ts.store(startNs, std::memory_order_relaxed);
+    s.dur.store(durNs, std::memory_order_relaxed);
+    s.arg.store(arg, std::memory_order_relaxed);
+    r->head.store(h + 1, std::memory_order_release);
+}
+
+long dump(const std::string& path) {
+    struct Ev { const char* name; uint64_t ts, dur; int64_t arg; };
+    FILE* f = fopen(path.c_str(), "w");
+    if (!f) return -1;
+
+    std::lock_guard<std::mutex> lk(registryMtx);
+    long count = 0;
+    bool first = true;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (const auto& r : registry) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"",
+                first ? "" : ",\n", r->tid);
+        writeEscaped(f, r->name);
+        fprintf(f, "\"}}");
+        first = false;
+
+        // Copy what is in the ring, then drop anything the writer lapped meanwhile.
+        uint64_t h = r->head.load(std::memory_order_acquire);
+        uint64_t lo = h > RING_CAPACITY ? h - RING_CAPACITY : 0;
+        std::vector<Ev> evs;
+        evs.reserve(h - lo);
+        for (uint64_t i = lo; i < h; ++i) {
+            const Slot& s = r->slots[i % RING_CAPACITY];
+            evs.push_back({s.name.load(std::memory_order_relaxed), s.ts.load(std::memory_order_relaxed),
+                           s.dur.load(std::memory_order_relaxed), s.arg.load(std::memory_order_relaxed)});
+        }
+        // The writer fills slot h2 % RING_CAPACITY before publishing h2 + 1, so event
+        // h2 - RING_CAPACITY may already be half overwritten as well.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t h2 = r->head.load(std::memory_order_relaxed);
+        uint64_t valid = h2 + 1 > RING_CAPACITY ? h2 + 1 - RING_CAPACITY : 0;
+        for (uint64_t i = lo; i < h; ++i) {
+            if (i < valid) continue;
+            const Ev& e = evs[i - lo];
+            fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"server\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                       "\"ts\":%.3f,\"dur\":%.3f",
+                    e.name, r->tid, e.ts / 1000.0, e.dur / 1000.0);
+            if (e.arg >= 0) fprintf(f, ",\"args\":{\"n\":%lld}", (long long)e.arg);
+            fprintf(f, "}");
+            ++count;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    if (fclose(f) != 0) return -1;
+    return count;
+}
+
+} // namespace trace